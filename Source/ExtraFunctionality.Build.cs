@@ -13,8 +13,9 @@ public class ExtraFunctionality : ModuleRules
         PrivateIncludePaths.Add(Path.Combine(ModuleDirectory, "Private"));
 
 
-        //PublicDependencyModuleNames.AddRange(new string[] {
-        //});
+        PublicDependencyModuleNames.AddRange(new string[] {
+            "ProceduralMeshComponent",
+        });
 
         PrivateDependencyModuleNames.AddRange(new string[] {
             "ApplicationCore",
@@ -0,0 +1,402 @@
+#include "ExtraBakedSplineMesh.h"
+#include "Async/ParallelFor.h"
+#include "Components/SplineComponent.h"
+#include "Engine/StaticMesh.h"
+#include "ExtraFunctionalityLibrary.h"
+#include "ExtraMemoryTracking.h"
+#include "ExtraPlatformProfile.h"
+#include "ExtraSplineMeshBuilder.h"
+#include "KismetProceduralMeshLibrary.h"
+#include "StaticMeshResources.h"
+
+DEFINE_LOG_CATEGORY(LogExtraBakedSplineMesh);
+
+namespace ExtraBakedSplineMesh
+{
+	/** Vertex count past which tiles are deformed on multiple threads */
+	static const int32 MinVerticesForParallel = 2048;
+	/** Mesh bounds corners at the start, middle and end of a tile make up its collision hull */
+	static const int32 HullSlicesPerTile = 3;
+	static const int32 HullPointsPerTile = HullSlicesPerTile * 4;
+
+	struct FMeshSection
+	{
+		TArray<FVector> Vertices;
+		TArray<int32> Triangles;
+		TArray<FVector> Normals;
+		TArray<FVector2D> UVs;
+		TArray<FProcMeshTangent> Tangents;
+		int32 MaterialIndex;
+	};
+
+	/** Hash of the settings that change the baked tiles, the debug settings are left out since they don't */
+	static uint32 HashConstructionInfo(const FExtraSplineConstructionInfo& Info)
+	{
+		uint32 Hash = GetTypeHash(Info.SplineMesh);
+		for (const UMaterialInterface* const Material : Info.OptionalMaterials)
+		{
+			Hash = HashCombine(Hash, GetTypeHash(Material));
+		}
+		Hash = HashCombine(Hash, GetTypeHash(Info.SplineTileLength));
+		Hash = HashCombine(Hash, GetTypeHash(Info.StartScale));
+		Hash = HashCombine(Hash, GetTypeHash(Info.EndScale));
+		Hash = HashCombine(Hash, GetTypeHash((uint8)Info.ForwardAxis));
+		Hash = HashCombine(Hash, GetTypeHash((uint8)Info.bAffectNavigation));
+		Hash = HashCombine(Hash, GetTypeHash((uint8)Info.bGenerateOverlapEvents));
+		Hash = HashCombine(Hash, GetTypeHash((uint8)Info.CollisionEnabled));
+		Hash = HashCombine(Hash, GetTypeHash((uint8)Info.ObjectType));
+		Hash = HashCombine(Hash, GetTypeHash((uint8)Info.Mobility));
+		Hash = HashCombine(Hash, GetTypeHash(Info.TilesPerCollisionBody));
+		Hash = HashCombine(Hash, GetTypeHash(Info.CullDistance));
+		Hash = HashCombine(Hash, GetTypeHash((uint8)Info.bCastShadow));
+		return Hash;
+	}
+}
+
+UExtraBakedSplineMeshComponent::UExtraBakedSplineMeshComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = true;
+	bTickInEditor = true;
+	bUseAsyncCooking = true;
+	bUseComplexAsSimpleCollision = false;
+
+	TilesPerChunk = 0;
+	bRebakeWhenSplineChanges = true;
+	Spline = nullptr;
+	BakedHash = 0;
+}
+
+UExtraBakedSplineMeshComponent* UExtraBakedSplineMeshComponent::BakeSplineMeshesAlongSpline(USplineComponent* SplineComp,
+	FExtraSplineConstructionInfo ConstructionInfo, int32 TilesPerChunk, bool bRebakeWhenSplineChanges)
+{
+	if (!SplineComp || !ConstructionInfo.SplineMesh)
+	{
+		return nullptr;
+	}
+
+	UExtraBakedSplineMeshComponent* const BakedMesh = NewObject<UExtraBakedSplineMeshComponent>(SplineComp);
+	BakedMesh->ConstructionInfo = ConstructionInfo;
+	BakedMesh->TilesPerChunk = FMath::Max(TilesPerChunk, 0);
+	BakedMesh->bRebakeWhenSplineChanges = bRebakeWhenSplineChanges;
+	BakedMesh->SetupAttachment(SplineComp);
+	BakedMesh->SetRelativeTransform(FTransform());
+	BakedMesh->SetComponentTickEnabled(bRebakeWhenSplineChanges);
+	// Registering bakes it
+	BakedMesh->RegisterComponent();
+	return BakedMesh;
+}
+
+void UExtraBakedSplineMeshComponent::SetSpline(USplineComponent* SplineComp)
+{
+	Spline = SplineComp;
+}
+
+USplineComponent* UExtraBakedSplineMeshComponent::GetSpline() const
+{
+	return Spline ? Spline : Cast<USplineComponent>(GetAttachParent());
+}
+
+void UExtraBakedSplineMeshComponent::Bake()
+{
+	EXTRA_LLM_SCOPE(SplineMeshes);
+	USplineComponent* const SplineComp = GetSpline();
+	UStaticMesh* const Mesh = ConstructionInfo.SplineMesh;
+	if (!SplineComp || !Mesh || !Mesh->RenderData || Mesh->RenderData->LODResources.Num() == 0)
+	{
+		// Recorded so ticking doesn't retry(and warn) every frame until something changes
+		BakedHash = GetBakeHash();
+		UE_LOG(LogExtraBakedSplineMesh, Warning, TEXT("%s can't bake, it needs a spline and a spline mesh with render data"), *GetName());
+		return;
+	}
+
+	TArray<FExtraSplineMeshTile> Tiles;
+	FExtraSplineMeshBuilder::ComputeTiles(SplineComp, ConstructionInfo, Tiles);
+	// Hashed after computing the tiles since that rewrites the spline's up vectors
+	BakedHash = GetBakeHash();
+
+	// Read the mesh once, every tile deforms the same source vertices
+	const FStaticMeshLODResources& LODResource = Mesh->RenderData->LODResources[0];
+	const int32 NumSections = LODResource.Sections.Num();
+	TArray<ExtraBakedSplineMesh::FMeshSection> SourceSections;
+	SourceSections.SetNum(NumSections);
+	int32 NumSourceVertices = 0;
+	for (int32 SectionIndex = 0; SectionIndex < NumSections; SectionIndex++)
+	{
+		ExtraBakedSplineMesh::FMeshSection& Source = SourceSections[SectionIndex];
+		UKismetProceduralMeshLibrary::GetSectionFromStaticMesh(Mesh, 0, SectionIndex,
+			Source.Vertices, Source.Triangles, Source.Normals, Source.UVs, Source.Tangents);
+		Source.MaterialIndex = LODResource.Sections[SectionIndex].MaterialIndex;
+		NumSourceVertices += Source.Vertices.Num();
+	}
+
+	const int32 NumTiles = Tiles.Num();
+	const int32 ChunkTiles = (TilesPerChunk > 0) ? TilesPerChunk : FMath::Max(NumTiles, 1);
+	const int32 NumChunks = FMath::DivideAndRoundUp(NumTiles, ChunkTiles);
+
+	// Size every output up front so each tile writes its own range and the tiles can be deformed in parallel
+	TArray<ExtraBakedSplineMesh::FMeshSection> BakedSections;
+	BakedSections.SetNum(NumChunks * NumSections);
+	for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ChunkIndex++)
+	{
+		const int32 NumChunkTiles = FMath::Min(ChunkTiles, NumTiles - (ChunkIndex * ChunkTiles));
+		for (int32 SectionIndex = 0; SectionIndex < NumSections; SectionIndex++)
+		{
+			const ExtraBakedSplineMesh::FMeshSection& Source = SourceSections[SectionIndex];
+			ExtraBakedSplineMesh::FMeshSection& Baked = BakedSections[(ChunkIndex * NumSections) + SectionIndex];
+			Baked.Vertices.SetNumUninitialized(NumChunkTiles * Source.Vertices.Num());
+			Baked.Triangles.SetNumUninitialized(NumChunkTiles * Source.Triangles.Num());
+			Baked.Normals.SetNumUninitialized(NumChunkTiles * Source.Normals.Num());
+			Baked.UVs.SetNumUninitialized(NumChunkTiles * Source.UVs.Num());
+			Baked.Tangents.SetNumUninitialized(NumChunkTiles * Source.Tangents.Num());
+			Baked.MaterialIndex = Source.MaterialIndex;
+		}
+	}
+
+	const bool bBakeCollision = (ConstructionInfo.CollisionEnabled != ECollisionEnabled::NoCollision);
+	TArray<FVector> HullPoints;
+	HullPoints.SetNumUninitialized(bBakeCollision ? (NumTiles * ExtraBakedSplineMesh::HullPointsPerTile) : 0);
+
+	const FBox MeshBox = Mesh->GetBoundingBox();
+	const int32 ForwardAxis = ConstructionInfo.ForwardAxis;
+	const int32 RightAxis = (ConstructionInfo.ForwardAxis == ESplineMeshAxis::X) ? 1 : 0;
+	const int32 UpAxis = (ConstructionInfo.ForwardAxis == ESplineMeshAxis::Z) ? 1 : 2;
+	const float MeshMinForward = MeshBox.Min[ForwardAxis];
+	const float MeshForwardRange = FMath::Max(MeshBox.Max[ForwardAxis] - MeshMinForward, KINDA_SMALL_NUMBER);
+
+	ParallelFor(NumTiles, [&](int32 TileIndex)
+	{
+		const FExtraSplineMeshTile& Tile = Tiles[TileIndex];
+		const int32 ChunkIndex = TileIndex / ChunkTiles;
+		const int32 ChunkTileIndex = TileIndex - (ChunkIndex * ChunkTiles);
+
+		for (int32 SectionIndex = 0; SectionIndex < NumSections; SectionIndex++)
+		{
+			const ExtraBakedSplineMesh::FMeshSection& Source = SourceSections[SectionIndex];
+			ExtraBakedSplineMesh::FMeshSection& Baked = BakedSections[(ChunkIndex * NumSections) + SectionIndex];
+			const int32 VertexOffset = ChunkTileIndex * Source.Vertices.Num();
+			const bool bHasNormals = (Source.Normals.Num() == Source.Vertices.Num());
+			const bool bHasUVs = (Source.UVs.Num() == Source.Vertices.Num());
+			const bool bHasTangents = (Source.Tangents.Num() == Source.Vertices.Num());
+
+			for (int32 VertexIndex = 0; VertexIndex < Source.Vertices.Num(); VertexIndex++)
+			{
+				FVector Position = Source.Vertices[VertexIndex];
+				const float Alpha = (Position[ForwardAxis] - MeshMinForward) / MeshForwardRange;
+				Position[ForwardAxis] = 0.0f;
+
+				const FTransform SliceTransform = FExtraSplineMeshBuilder::CalcSliceTransform(Tile, ConstructionInfo, Alpha);
+				Baked.Vertices[VertexOffset + VertexIndex] = SliceTransform.TransformPosition(Position);
+				if (bHasNormals)
+				{
+					// Normals take the inverse scale so they stay perpendicular to squashed surfaces
+					const FVector InvScale = SliceTransform.GetSafeScaleReciprocal(SliceTransform.GetScale3D());
+					Baked.Normals[VertexOffset + VertexIndex] = SliceTransform.TransformVectorNoScale(Source.Normals[VertexIndex] * InvScale).GetSafeNormal();
+				}
+				if (bHasUVs)
+				{
+					Baked.UVs[VertexOffset + VertexIndex] = Source.UVs[VertexIndex];
+				}
+				if (bHasTangents)
+				{
+					FProcMeshTangent Tangent = Source.Tangents[VertexIndex];
+					Tangent.TangentX = SliceTransform.TransformVector(Tangent.TangentX).GetSafeNormal();
+					Baked.Tangents[VertexOffset + VertexIndex] = Tangent;
+				}
+			}
+
+			const int32 TriangleOffset = ChunkTileIndex * Source.Triangles.Num();
+			for (int32 TriangleIndex = 0; TriangleIndex < Source.Triangles.Num(); TriangleIndex++)
+			{
+				Baked.Triangles[TriangleOffset + TriangleIndex] = Source.Triangles[TriangleIndex] + VertexOffset;
+			}
+		}
+
+		if (bBakeCollision)
+		{
+			for (int32 SliceIndex = 0; SliceIndex < ExtraBakedSplineMesh::HullSlicesPerTile; SliceIndex++)
+			{
+				const float Alpha = (float)SliceIndex / (ExtraBakedSplineMesh::HullSlicesPerTile - 1);
+				const FTransform SliceTransform = FExtraSplineMeshBuilder::CalcSliceTransform(Tile, ConstructionInfo, Alpha);
+				for (int32 CornerIndex = 0; CornerIndex < 4; CornerIndex++)
+				{
+					FVector Corner = FVector::ZeroVector;
+					Corner[RightAxis] = (CornerIndex & 1) ? MeshBox.Max[RightAxis] : MeshBox.Min[RightAxis];
+					Corner[UpAxis] = (CornerIndex & 2) ? MeshBox.Max[UpAxis] : MeshBox.Min[UpAxis];
+					HullPoints[(TileIndex * ExtraBakedSplineMesh::HullPointsPerTile) + (SliceIndex * 4) + CornerIndex] = SliceTransform.TransformPosition(Corner);
+				}
+			}
+		}
+	}, FExtraPlatformProfiler::ShouldForceSingleThread(NumTiles * NumSourceVertices, ExtraBakedSplineMesh::MinVerticesForParallel));
+
+	// Components can only be touched on the game thread
+	const TArray<UMaterialInterface*> Materials = FExtraSplineMeshBuilder::GetTileMaterials(ConstructionInfo);
+	const int32 TilesPerBody = FMath::Max(ConstructionInfo.TilesPerCollisionBody, 1);
+	for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ChunkIndex++)
+	{
+		UProceduralMeshComponent* const Chunk = GetOrCreateChunk(ChunkIndex);
+		Chunk->ClearAllMeshSections();
+		SetupChunk(Chunk);
+
+		for (int32 SectionIndex = 0; SectionIndex < NumSections; SectionIndex++)
+		{
+			const ExtraBakedSplineMesh::FMeshSection& Baked = BakedSections[(ChunkIndex * NumSections) + SectionIndex];
+			Chunk->CreateMeshSection_LinearColor(SectionIndex, Baked.Vertices, Baked.Triangles, Baked.Normals, Baked.UVs,
+				TArray<FLinearColor>(), Baked.Tangents, false);
+			if (Materials.IsValidIndex(Baked.MaterialIndex) && Materials[Baked.MaterialIndex])
+			{
+				Chunk->SetMaterial(SectionIndex, Materials[Baked.MaterialIndex]);
+			}
+		}
+
+		// A convex hull per group of tiles instead of per triangle collision
+		TArray<TArray<FVector>> ConvexMeshes;
+		if (bBakeCollision)
+		{
+			const int32 FirstTile = ChunkIndex * ChunkTiles;
+			const int32 EndTile = FMath::Min(FirstTile + ChunkTiles, NumTiles);
+			for (int32 BodyFirstTile = FirstTile; BodyFirstTile < EndTile; BodyFirstTile += TilesPerBody)
+			{
+				const int32 NumBodyTiles = FMath::Min(TilesPerBody, EndTile - BodyFirstTile);
+				ConvexMeshes.Emplace(HullPoints.GetData() + (BodyFirstTile * ExtraBakedSplineMesh::HullPointsPerTile),
+					NumBodyTiles * ExtraBakedSplineMesh::HullPointsPerTile);
+			}
+		}
+		Chunk->SetCollisionConvexMeshes(ConvexMeshes);
+	}
+
+	if (NumChunks == 0)
+	{
+		ClearAllMeshSections();
+		ClearCollisionConvexMeshes();
+	}
+
+	// The spline got shorter, drop the chunks that aren't needed anymore
+	for (int32 index = ExtraChunks.Num(); index-- > FMath::Max(NumChunks - 1, 0);)
+	{
+		if (ExtraChunks[index])
+		{
+			ExtraChunks[index]->DestroyComponent();
+		}
+		ExtraChunks.RemoveAt(index, 1, false);
+	}
+
+	UE_LOG(LogExtraBakedSplineMesh, Verbose, TEXT("Baked %d tiles along %s into %d chunks"), NumTiles, *GetNameSafe(SplineComp), NumChunks);
+}
+
+bool UExtraBakedSplineMeshComponent::ConditionalRebake()
+{
+	if (!IsBakeOutOfDate())
+	{
+		return false;
+	}
+
+	Bake();
+	return true;
+}
+
+bool UExtraBakedSplineMeshComponent::IsBakeOutOfDate() const
+{
+	return GetSpline() && ConstructionInfo.SplineMesh && (GetBakeHash() != BakedHash);
+}
+
+TArray<UProceduralMeshComponent*> UExtraBakedSplineMeshComponent::GetChunks() const
+{
+	TArray<UProceduralMeshComponent*> Chunks;
+	Chunks.Reserve(ExtraChunks.Num() + 1);
+	Chunks.Add(const_cast<UExtraBakedSplineMeshComponent*>(this));
+	Chunks.Append(ExtraChunks);
+	return Chunks;
+}
+
+void UExtraBakedSplineMeshComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	// The extra chunks aren't saved or duplicated, so a loaded or PIE copy has to bake again
+	if (BakedHash == 0)
+	{
+		ConditionalRebake();
+	}
+}
+
+void UExtraBakedSplineMeshComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (bRebakeWhenSplineChanges)
+	{
+		ConditionalRebake();
+	}
+}
+
+void UExtraBakedSplineMeshComponent::OnComponentDestroyed(bool bDestroyingHierarchy)
+{
+	for (UProceduralMeshComponent* const Chunk : ExtraChunks)
+	{
+		if (Chunk && !Chunk->IsPendingKill())
+		{
+			Chunk->DestroyComponent();
+		}
+	}
+	ExtraChunks.Empty();
+
+	Super::OnComponentDestroyed(bDestroyingHierarchy);
+}
+
+UProceduralMeshComponent* UExtraBakedSplineMeshComponent::GetOrCreateChunk(int32 ChunkIndex)
+{
+	if (ChunkIndex == 0)
+	{
+		return this;
+	}
+
+	const int32 ExtraIndex = ChunkIndex - 1;
+	if (ExtraChunks.IsValidIndex(ExtraIndex) && ExtraChunks[ExtraIndex] && !ExtraChunks[ExtraIndex]->IsPendingKill())
+	{
+		return ExtraChunks[ExtraIndex];
+	}
+
+	UProceduralMeshComponent* const Chunk = NewObject<UProceduralMeshComponent>(this);
+	Chunk->SetupAttachment(this);
+	if (IsRegistered())
+	{
+		Chunk->RegisterComponent();
+	}
+
+	if (ExtraChunks.IsValidIndex(ExtraIndex))
+	{
+		ExtraChunks[ExtraIndex] = Chunk;
+	}
+	else
+	{
+		ExtraChunks.Add(Chunk);
+	}
+	return Chunk;
+}
+
+void UExtraBakedSplineMeshComponent::SetupChunk(UProceduralMeshComponent* Chunk) const
+{
+	Chunk->bUseAsyncCooking = true;
+	Chunk->bUseComplexAsSimpleCollision = false;
+	Chunk->SetMobility(ConstructionInfo.Mobility);
+	Chunk->SetCanEverAffectNavigation(ConstructionInfo.bAffectNavigation);
+	Chunk->SetGenerateOverlapEvents(ConstructionInfo.bGenerateOverlapEvents);
+	Chunk->SetCollisionObjectType(UEngineTypes::ConvertToCollisionChannel(ConstructionInfo.ObjectType));
+	Chunk->SetCollisionEnabled(ConstructionInfo.CollisionEnabled);
+	Chunk->SetCullDistance(ConstructionInfo.CullDistance);
+	Chunk->SetCastShadow(ConstructionInfo.bCastShadow);
+}
+
+uint32 UExtraBakedSplineMeshComponent::GetBakeHash() const
+{
+	const USplineComponent* const SplineComp = GetSpline();
+	if (!SplineComp)
+	{
+		return 0;
+	}
+
+	const uint32 Hash = HashCombine(UExtraFunctionalityLibrary::GetSplineCurvesHash(SplineComp), ExtraBakedSplineMesh::HashConstructionInfo(ConstructionInfo));
+	return HashCombine(Hash, GetTypeHash(TilesPerChunk));
+}
@@ -0,0 +1,366 @@
+#include "ExtraComponentLookup.h"
+#include "Components/ActorComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "ExtraMemoryTracking.h"
+#include "GameFramework/Actor.h"
+
+DEFINE_LOG_CATEGORY(LogExtraComponentLookup);
+
+namespace ExtraComponentLookup
+{
+	/** Fewest entries before stale actors are purged */
+	static const int32 MinPurgeThreshold = 256;
+	/** Most component signatures indexed per actor class before the class's index is re-seeded, bounds actors with runtime components */
+	static const int32 MaxSignaturesPerClass = 16;
+
+	static bool IsCachedComponentValid(const UActorComponent* Component, const AActor* Actor, FName ComponentName)
+	{
+		return Component && !Component->IsPendingKill() && Component->GetOwner() == Actor && Component->GetFName() == ComponentName;
+	}
+
+	/** Uncached lookup of every component of a class, for actors the class index doesn't match */
+	static int32 FindComponentsOfClassSlow(const AActor* Actor, const UClass* ComponentClass, TArray<UActorComponent*>& OutComponents, bool bFirstOnly)
+	{
+		for (UActorComponent* const Component : Actor->GetComponents())
+		{
+			if (Component && Component->IsA(ComponentClass))
+			{
+				OutComponents.Add(Component);
+				if (bFirstOnly)
+				{
+					break;
+				}
+			}
+		}
+		return OutComponents.Num();
+	}
+
+	/**
+	* Hash of the names and classes of every component of Actor, actors of the same class with the same signature have the same components.
+	* Summed per component so the order the components are stored in doesn't matter.
+	*/
+	static uint64 MakeComponentSignature(const AActor* Actor)
+	{
+		const TSet<UActorComponent*>& Components = Actor->GetComponents();
+		uint64 Signature = (uint64)Components.Num();
+		for (const UActorComponent* const Component : Components)
+		{
+			if (Component)
+			{
+				const uint64 ComponentHash = ((uint64)GetTypeHash(Component->GetFName()) << 32) | (uint64)GetTypeHash(Component->GetClass());
+				Signature += ComponentHash * 0x9E3779B97F4A7C15ull;
+			}
+		}
+		return Signature;
+	}
+
+	/** Uncached lookup for actors without a world */
+	static UActorComponent* FindComponentSlow(const AActor* Actor, FName ComponentName)
+	{
+		for (UActorComponent* const Component : Actor->GetComponents())
+		{
+			if (Component && Component->GetFName() == ComponentName)
+			{
+				return Component;
+			}
+		}
+		return nullptr;
+	}
+}
+
+UExtraComponentLookupSubsystem::UExtraComponentLookupSubsystem()
+{
+	PurgeThreshold = ExtraComponentLookup::MinPurgeThreshold;
+}
+
+void UExtraComponentLookupSubsystem::Deinitialize()
+{
+	ClearCache();
+
+	Super::Deinitialize();
+}
+
+UExtraComponentLookupSubsystem* UExtraComponentLookupSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (const UWorld* const World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull))
+	{
+		return World->GetSubsystem<UExtraComponentLookupSubsystem>();
+	}
+	return nullptr;
+}
+
+UActorComponent* UExtraComponentLookupSubsystem::FindComponentByName(AActor* Actor, FName ComponentName)
+{
+	if (!Actor || ComponentName.IsNone())
+	{
+		return nullptr;
+	}
+
+	if (UExtraComponentLookupSubsystem* const Subsystem = Get(Actor))
+	{
+		return Subsystem->FindComponent(Actor, ComponentName);
+	}
+	return ExtraComponentLookup::FindComponentSlow(Actor, ComponentName);
+}
+
+UActorComponent* UExtraComponentLookupSubsystem::FindComponent(AActor* Actor, FName ComponentName)
+{
+	if (!Actor || ComponentName.IsNone())
+	{
+		return nullptr;
+	}
+
+	bool bBuilt = false;
+	FActorEntry& Entry = FindOrBuildEntry(Actor, bBuilt);
+	const TWeakObjectPtr<UActorComponent>* const CachedComponent = Entry.ComponentsByName.Find(ComponentName);
+	UActorComponent* const Component = CachedComponent ? CachedComponent->Get() : nullptr;
+	if (ExtraComponentLookup::IsCachedComponentValid(Component, Actor, ComponentName))
+	{
+		return Component;
+	}
+	return FindUncachedComponent(Actor, Entry, ComponentName, CachedComponent != nullptr, bBuilt);
+}
+
+int32 UExtraComponentLookupSubsystem::FindComponents(AActor* Actor, const TArray<FName>& ComponentNames, TArray<UActorComponent*>& OutComponents)
+{
+	OutComponents.Reset(ComponentNames.Num());
+	if (!Actor)
+	{
+		OutComponents.AddZeroed(ComponentNames.Num());
+		return 0;
+	}
+
+	bool bBuilt = false;
+	FActorEntry& Entry = FindOrBuildEntry(Actor, bBuilt);
+
+	int32 NumFound = 0;
+	for (const FName& ComponentName : ComponentNames)
+	{
+		const TWeakObjectPtr<UActorComponent>* const CachedComponent = ComponentName.IsNone() ? nullptr : Entry.ComponentsByName.Find(ComponentName);
+		UActorComponent* Component = CachedComponent ? CachedComponent->Get() : nullptr;
+		if (!ComponentName.IsNone() && !ExtraComponentLookup::IsCachedComponentValid(Component, Actor, ComponentName))
+		{
+			Component = FindUncachedComponent(Actor, Entry, ComponentName, CachedComponent != nullptr, bBuilt);
+		}
+
+		OutComponents.Add(Component);
+		NumFound += (Component != nullptr);
+	}
+	return NumFound;
+}
+
+UActorComponent* UExtraComponentLookupSubsystem::FindComponentByClass(AActor* Actor, TSubclassOf<UActorComponent> ComponentClass)
+{
+	if (!Actor || !ComponentClass)
+	{
+		return nullptr;
+	}
+
+	if (UExtraComponentLookupSubsystem* const Subsystem = Get(Actor))
+	{
+		return Subsystem->FindComponentOfClass(Actor, ComponentClass);
+	}
+	return Actor->FindComponentByClass(ComponentClass);
+}
+
+UActorComponent* UExtraComponentLookupSubsystem::FindComponentOfClass(AActor* Actor, TSubclassOf<UActorComponent> ComponentClass)
+{
+	if (!Actor || !ComponentClass)
+	{
+		return nullptr;
+	}
+
+	// The slots were recorded from an actor with exactly the same components, so an empty list is a real miss
+	bool bBuilt = false;
+	FActorEntry& Entry = FindOrBuildEntry(Actor, bBuilt);
+	const TArray<FName>& Slots = FindOrBuildClassSlots(Actor, Entry, ComponentClass);
+	if (Slots.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	TArray<UActorComponent*> Resolved;
+	if (ResolveClassSlots(Actor, ComponentClass, Slots, Resolved, true))
+	{
+		return Resolved[0];
+	}
+
+	// A component was renamed or swapped without changing the count, so the cached signature is out of date
+	BuildEntry(Actor, Entry);
+	return Actor->FindComponentByClass(ComponentClass);
+}
+
+int32 UExtraComponentLookupSubsystem::FindComponentsOfClass(AActor* Actor, TSubclassOf<UActorComponent> ComponentClass, TArray<UActorComponent*>& OutComponents)
+{
+	OutComponents.Reset();
+	if (!Actor || !ComponentClass)
+	{
+		return 0;
+	}
+
+	bool bBuilt = false;
+	FActorEntry& Entry = FindOrBuildEntry(Actor, bBuilt);
+	const TArray<FName>& Slots = FindOrBuildClassSlots(Actor, Entry, ComponentClass);
+	if (ResolveClassSlots(Actor, ComponentClass, Slots, OutComponents, false))
+	{
+		return OutComponents.Num();
+	}
+
+	BuildEntry(Actor, Entry);
+	OutComponents.Reset();
+	return ExtraComponentLookup::FindComponentsOfClassSlow(Actor, ComponentClass, OutComponents, false);
+}
+
+void UExtraComponentLookupSubsystem::InvalidateActor(AActor* Actor)
+{
+	Entries.Remove(Actor);
+}
+
+void UExtraComponentLookupSubsystem::ClearCache()
+{
+	Entries.Empty();
+	ClassEntries.Empty();
+	PurgeThreshold = ExtraComponentLookup::MinPurgeThreshold;
+}
+
+const TArray<FName>& UExtraComponentLookupSubsystem::FindOrBuildClassSlots(AActor* Actor, FActorEntry& Entry, UClass* ComponentClass)
+{
+	EXTRA_LLM_SCOPE(Caches);
+	FActorClassEntry* ClassEntry = ClassEntries.Find(Actor->GetClass());
+	if (!ClassEntry)
+	{
+		ConditionalPurge();
+		ClassEntry = &ClassEntries.Add(Actor->GetClass());
+	}
+
+	// Actors whose components differ from the rest of their class(added at runtime, made by their construction script, renamed...)
+	// are indexed under their own signature, the index is re-seeded if a class ends up with too many of them
+	TMap<TWeakObjectPtr<UClass>, TArray<FName>>* ComponentNamesByClass = ClassEntry->ComponentNamesBySignature.Find(Entry.Signature);
+	if (!ComponentNamesByClass)
+	{
+		if (ClassEntry->ComponentNamesBySignature.Num() >= ExtraComponentLookup::MaxSignaturesPerClass)
+		{
+			UE_LOG(LogExtraComponentLookup, Verbose, TEXT("Re-seeding the component index of %s, its actors had more than %d component signatures"), 
+				*GetNameSafe(Actor->GetClass()), ExtraComponentLookup::MaxSignaturesPerClass);
+			ClassEntry->ComponentNamesBySignature.Reset();
+		}
+		ComponentNamesByClass = &ClassEntry->ComponentNamesBySignature.Add(Entry.Signature);
+	}
+
+	if (const TArray<FName>* const Slots = ComponentNamesByClass->Find(ComponentClass))
+	{
+		return *Slots;
+	}
+
+	TArray<UActorComponent*> Components;
+	ExtraComponentLookup::FindComponentsOfClassSlow(Actor, ComponentClass, Components, false);
+	TArray<FName>& Slots = ComponentNamesByClass->Add(ComponentClass);
+	Slots.Reserve(Components.Num());
+	for (const UActorComponent* const Component : Components)
+	{
+		Slots.Add(Component->GetFName());
+	}
+	return Slots;
+}
+
+bool UExtraComponentLookupSubsystem::ResolveClassSlots(AActor* Actor, UClass* ComponentClass, const TArray<FName>& Slots, 
+	TArray<UActorComponent*>& OutComponents, bool bFirstOnly)
+{
+	for (const FName& Slot : Slots)
+	{
+		// Components are outered to their actor, so this is a hash lookup instead of a search
+		UActorComponent* const Component = FindObjectFast<UActorComponent>(Actor, Slot);
+		if (!Component || Component->IsPendingKill() || Component->GetOwner() != Actor || !Component->IsA(ComponentClass))
+		{
+			return false;
+		}
+
+		OutComponents.Add(Component);
+		if (bFirstOnly)
+		{
+			break;
+		}
+	}
+	return true;
+}
+
+UActorComponent* UExtraComponentLookupSubsystem::FindUncachedComponent(AActor* Actor, FActorEntry& Entry, FName ComponentName, bool bWasCached, bool& bInOutBuilt)
+{
+	// A freshly built entry is up to date, so the miss is real
+	if (bInOutBuilt)
+	{
+		return nullptr;
+	}
+
+	// Renaming or swapping components keeps the count the same, so a miss is checked against the actor before it's trusted
+	UActorComponent* const Component = ExtraComponentLookup::FindComponentSlow(Actor, ComponentName);
+	if (Component || bWasCached)
+	{
+		BuildEntry(Actor, Entry);
+		bInOutBuilt = true;
+	}
+	return Component;
+}
+
+UExtraComponentLookupSubsystem::FActorEntry& UExtraComponentLookupSubsystem::FindOrBuildEntry(AActor* Actor, bool& bOutBuilt)
+{
+	bOutBuilt = false;
+	FActorEntry* Entry = Entries.Find(Actor);
+	if (!Entry)
+	{
+		ConditionalPurge();
+		Entry = &Entries.Add(Actor);
+		Entry->NumComponents = INDEX_NONE;
+		Entry->Signature = 0;
+	}
+
+	// A component was added or removed since the entry was built
+	if (Entry->NumComponents != Actor->GetComponents().Num())
+	{
+		BuildEntry(Actor, *Entry);
+		bOutBuilt = true;
+	}
+	return *Entry;
+}
+
+void UExtraComponentLookupSubsystem::BuildEntry(AActor* Actor, FActorEntry& Entry)
+{
+	EXTRA_LLM_SCOPE(Caches);
+	const TSet<UActorComponent*>& Components = Actor->GetComponents();
+	Entry.NumComponents = Components.Num();
+	Entry.Signature = ExtraComponentLookup::MakeComponentSignature(Actor);
+	Entry.ComponentsByName.Reset();
+	Entry.ComponentsByName.Reserve(Components.Num());
+	for (UActorComponent* const Component : Components)
+	{
+		if (Component)
+		{
+			Entry.ComponentsByName.Add(Component->GetFName(), Component);
+		}
+	}
+}
+
+void UExtraComponentLookupSubsystem::ConditionalPurge()
+{
+	if (Entries.Num() < PurgeThreshold && ClassEntries.Num() < PurgeThreshold)
+	{
+		return;
+	}
+
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+	for (auto It = ClassEntries.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+	PurgeThreshold = FMath::Max(ExtraComponentLookup::MinPurgeThreshold, FMath::Max(Entries.Num(), ClassEntries.Num()) * 2);
+}
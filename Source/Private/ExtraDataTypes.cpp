@@ -14,6 +14,12 @@ FExtraSplineConstructionInfo::FExtraSplineConstructionInfo()
 	CollisionEnabled = ECollisionEnabled::NoCollision;
 	ObjectType = UEngineTypes::ConvertToObjectType(ECollisionChannel::ECC_WorldStatic);	
 	Mobility = EComponentMobility::Movable;
+	TilesPerCollisionBody = 0;
+
+	CullDistance = 0.0f;
+	bCastShadow = true;
+
+	bUseComponentPool = false;
 
 	bDebugMode = false;
 	ArrowLength = 100.0f;
@@ -21,3 +27,148 @@ FExtraSplineConstructionInfo::FExtraSplineConstructionInfo()
 	ArrowThickness = 2.5f;
 	DebugTime = 5.0f;
 }
+
+FExtraSplineScatterInfo::FExtraSplineScatterInfo()
+{
+	Mesh = nullptr;
+	Spacing = 200.0f;
+	StartOffset = 0.0f;
+	bAlignToSpline = true;
+
+	LocationJitter = FVector::ZeroVector;
+	RotationJitter = FRotator::ZeroRotator;
+	MinScale = 1.0f;
+	MaxScale = 1.0f;
+	RandomSeed = 0;
+
+	bSnapToGround = false;
+	GroundTraceDistance = 1000.0f;
+	GroundChannel = UEngineTypes::ConvertToTraceType(ECollisionChannel::ECC_Visibility);
+	bTraceComplex = false;
+	bUseGroundHeightCache = false;
+
+	CollisionEnabled = ECollisionEnabled::NoCollision;
+	ObjectType = UEngineTypes::ConvertToObjectType(ECollisionChannel::ECC_WorldStatic);
+
+	CullDistance = 0.0f;
+	bCastShadow = true;
+}
+
+FExtraReplayInfo::FExtraReplayInfo()
+{
+	DurationInSeconds = 0.0f;
+	SizeInBytes = 0;
+	bIsLive = false;
+}
+
+FExtraComponentPoolStats::FExtraComponentPoolStats()
+{
+	NumPooled = 0;
+	NumHits = 0;
+	NumMisses = 0;
+	NumReleased = 0;
+	NumDestroyedOverCap = 0;
+}
+
+FExtraRenderDirtyStats::FExtraRenderDirtyStats()
+{
+	NumMarks = 0;
+	NumRedundantMarks = 0;
+	NumFlushedComponents = 0;
+	NumFlushes = 0;
+}
+
+FExtraDebugArrowSettings::FExtraDebugArrowSettings()
+{
+	ArrowLength = 200.0f;
+	ArrowSize = 100.0f;
+	ArrowThickness = 5.0f;
+	ForwardColor = FLinearColor::Red;
+	RightColor = FLinearColor::Green;
+	UpColor = FLinearColor::Blue;
+	Duration = 5.0f;
+	CullDistance = 0.0f;
+}
+
+FExtraSplineSimplifyResult::FExtraSplineSimplifyResult()
+{
+	OriginalNumPoints = 0;
+	NumPoints = 0;
+	MaxPositionDeviation = 0.0f;
+	MaxAngleDeviation = 0.0f;
+	MaxScaleDeviation = 0.0f;
+}
+
+FExtraWorkSchedulerStats::FExtraWorkSchedulerStats()
+{
+	NumPendingGameThreadWork = 0;
+	NumPendingAsyncWork = 0;
+	NumCompletedWork = 0;
+	NumCancelledWork = 0;
+	NumBudgetOverruns = 0;
+	WorstOverrunMs = 0.0f;
+	LastFrameMs = 0.0f;
+}
+
+FExtraObjectHandle::FExtraObjectHandle()
+{
+	Index = INDEX_NONE;
+	Generation = 0;
+}
+
+FExtraObjectHandle::FExtraObjectHandle(int32 InIndex, int32 InGeneration)
+{
+	Index = InIndex;
+	Generation = InGeneration;
+}
+
+FExtraPlatformProfile::FExtraPlatformProfile()
+{
+	NumPhysicalCores = 1;
+	NumLogicalCores = 1;
+	NumWorkerThreads = 0;
+	CacheLineSize = 64;
+	TotalPhysicalMemoryMB = 0;
+	AvailablePhysicalMemoryMB = 0;
+	bHasSSE42 = false;
+	bHasAVX = false;
+	bHasAVX2 = false;
+	bHasNeon = false;
+	CPUScore = 0.0f;
+	BenchmarkMs = 0.0f;
+}
+
+FExtraScalabilityTier::FExtraScalabilityTier()
+{
+	TierName = NAME_None;
+	MinScore = 0.0f;
+	ScalabilityLevel = 3;
+	SplineBuildBudgetMs = 2.0f;
+	TracesPerFrame = 0;
+}
+
+FExtraScalabilityTier::FExtraScalabilityTier(FName InTierName, float InMinScore, int32 InScalabilityLevel, float InSplineBuildBudgetMs, int32 InTracesPerFrame)
+{
+	TierName = InTierName;
+	MinScore = InMinScore;
+	ScalabilityLevel = InScalabilityLevel;
+	SplineBuildBudgetMs = InSplineBuildBudgetMs;
+	TracesPerFrame = InTracesPerFrame;
+}
+
+FExtraCPUBenchmarkResult::FExtraCPUBenchmarkResult()
+{
+	SingleThreadScore = 0.0f;
+	MultiThreadScore = 0.0f;
+	CombinedScore = 0.0f;
+	BenchmarkMs = 0.0f;
+	bFromCache = false;
+	TierIndex = INDEX_NONE;
+}
+
+FExtraMemoryTagUsage::FExtraMemoryTagUsage()
+{
+	TagName = NAME_None;
+	CurrentBytes = 0;
+	PeakBytes = 0;
+}
@@ -0,0 +1,293 @@
+#include "ExtraDebugDraw.h"
+#include "Components/SceneComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "ExtraMemoryTracking.h"
+
+DEFINE_LOG_CATEGORY(LogExtraDebugDraw);
+
+namespace ExtraDebugDraw
+{
+	/** A coordinate arrow set is 3 arrows of 3 lines each */
+	static const int32 LinesPerCoordinateArrows = 9;
+
+	/** Same lines DrawDebugDirectionalArrow makes */
+	static void AddArrow(TArray<FBatchedLine>& Lines, const FVector& Start, const FVector& End, float ArrowSize, const FLinearColor& Color, float Thickness)
+	{
+		Lines.Emplace(Start, End, Color, 0.0f, Thickness, SDPG_World);
+
+		FVector Dir = (End - Start);
+		Dir.Normalize();
+		FVector Up(0.0f, 0.0f, 1.0f);
+		FVector Right = Dir ^ Up;
+		if (!Right.IsNormalized())
+		{
+			Dir.FindBestAxisVectors(Up, Right);
+		}
+		const FVector Origin = FVector::ZeroVector;
+		const FMatrix TM(Dir, Right, Up, Origin);
+
+		// Since dir is x direction, my arrow will be pointing +y, -x and -y, -x
+		const float ArrowSqrtSize = FMath::Sqrt(ArrowSize);
+		Lines.Emplace(End, End + TM.TransformPosition(FVector(-ArrowSqrtSize, ArrowSqrtSize, 0.0f)), Color, 0.0f, Thickness, SDPG_World);
+		Lines.Emplace(End, End + TM.TransformPosition(FVector(-ArrowSqrtSize, -ArrowSqrtSize, 0.0f)), Color, 0.0f, Thickness, SDPG_World);
+	}
+}
+
+UExtraDebugDrawSubsystem::UExtraDebugDrawSubsystem()
+{
+	CullUpdateDistance = 100.0f;
+	LineBatcher = nullptr;
+	LastHandle = 0;
+	bLinesDirty = false;
+	bUsesCulling = false;
+}
+
+void UExtraDebugDrawSubsystem::Deinitialize()
+{
+	Entries.Empty();
+	if (LineBatcher)
+	{
+		LineBatcher->DestroyComponent();
+		LineBatcher = nullptr;
+	}
+
+	Super::Deinitialize();
+}
+
+UExtraDebugDrawSubsystem* UExtraDebugDrawSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (const UWorld* const World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull))
+	{
+		return World->GetSubsystem<UExtraDebugDrawSubsystem>();
+	}
+	return nullptr;
+}
+
+int32 UExtraDebugDrawSubsystem::DrawCoordinateArrowsAtTransforms(const TArray<FTransform>& Transforms, const FExtraDebugArrowSettings& Settings, int32 Handle)
+{
+	EXTRA_LLM_SCOPE(Caches);
+#if ENABLE_DRAW_DEBUG
+	if (Handle == 0 || !Entries.Contains(Handle))
+	{
+		Handle = MakeHandle();
+	}
+
+	FEntry& Entry = Entries.FindOrAdd(Handle);
+	Entry.Lines.Reset(Transforms.Num() * ExtraDebugDraw::LinesPerCoordinateArrows);
+	Entry.ItemLocations.Reset(Transforms.Num());
+	Entry.LinesPerItem = ExtraDebugDraw::LinesPerCoordinateArrows;
+	Entry.CullDistance = Settings.CullDistance;
+	// World time like the engine's debug draws, so the lines don't run out while the game is paused
+	Entry.ExpireTime = (Settings.Duration > 0.0f && GetWorld()) ? (GetWorld()->GetTimeSeconds() + Settings.Duration) : 0.0f;
+	Entry.bDrawn = false;
+
+	for (const FTransform& Transform : Transforms)
+	{
+		const FVector StartLoc = Transform.GetLocation();
+		const FQuat Rotation = Transform.GetRotation();
+		Entry.ItemLocations.Add(StartLoc);
+
+		// X
+		ExtraDebugDraw::AddArrow(Entry.Lines, StartLoc, StartLoc + (Rotation.GetForwardVector() * Settings.ArrowLength),
+			Settings.ArrowSize, Settings.ForwardColor, Settings.ArrowThickness);
+		// Y
+		ExtraDebugDraw::AddArrow(Entry.Lines, StartLoc, StartLoc + (Rotation.GetRightVector() * Settings.ArrowLength),
+			Settings.ArrowSize, Settings.RightColor, Settings.ArrowThickness);
+		// Z
+		ExtraDebugDraw::AddArrow(Entry.Lines, StartLoc, StartLoc + (Rotation.GetUpVector() * Settings.ArrowLength),
+			Settings.ArrowSize, Settings.UpColor, Settings.ArrowThickness);
+	}
+
+	bLinesDirty = true;
+	return Handle;
+#else
+	return 0;
+#endif
+}
+
+int32 UExtraDebugDrawSubsystem::DrawCoordinateArrowsAtComponents(const TArray<USceneComponent*>& Components, FVector Offset,
+	const FExtraDebugArrowSettings& Settings, int32 Handle)
+{
+#if ENABLE_DRAW_DEBUG
+	TArray<FTransform> Transforms;
+	Transforms.Reserve(Components.Num());
+	for (const USceneComponent* const Component : Components)
+	{
+		if (Component)
+		{
+			Transforms.Emplace(Component->GetComponentQuat(), Component->GetComponentLocation() + Offset);
+		}
+	}
+	return DrawCoordinateArrowsAtTransforms(Transforms, Settings, Handle);
+#else
+	return 0;
+#endif
+}
+
+void UExtraDebugDrawSubsystem::RemoveDebugDraw(int32 Handle)
+{
+	if (Entries.Remove(Handle) > 0)
+	{
+		bLinesDirty = true;
+	}
+}
+
+void UExtraDebugDrawSubsystem::ClearDebugDraws()
+{
+	ObjectHandles.Empty();
+	if (Entries.Num() > 0)
+	{
+		Entries.Empty();
+		bLinesDirty = true;
+	}
+}
+
+int32 UExtraDebugDrawSubsystem::GetObjectHandle(const UObject* Object) const
+{
+	const int32* const Handle = ObjectHandles.Find(Object);
+	return (Handle && Entries.Contains(*Handle)) ? *Handle : 0;
+}
+
+void UExtraDebugDrawSubsystem::SetObjectHandle(const UObject* Object, int32 Handle)
+{
+	// Forget objects that are gone or whose arrows expired, so the map doesn't grow with every object ever drawn for
+	for (auto It = ObjectHandles.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid() || !Entries.Contains(It.Value()))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	if (Object && Handle != 0)
+	{
+		ObjectHandles.Add(Object, Handle);
+	}
+}
+
+void UExtraDebugDrawSubsystem::Tick(float DeltaTime)
+{
+	const float Now = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f;
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		if (It.Value().bDrawn && It.Value().ExpireTime > 0.0f && It.Value().ExpireTime <= Now)
+		{
+			It.RemoveCurrent();
+			bLinesDirty = true;
+		}
+	}
+
+	// Only recheck culling once a view moved enough to matter
+	TArray<FVector> ViewLocations;
+	if (!bLinesDirty && bUsesCulling && GetViewLocations(ViewLocations) && HaveViewsMoved(ViewLocations))
+	{
+		bLinesDirty = true;
+	}
+
+	if (bLinesDirty)
+	{
+		RebuildLines();
+	}
+}
+
+TStatId UExtraDebugDrawSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UExtraDebugDrawSubsystem, STATGROUP_Tickables);
+}
+
+int32 UExtraDebugDrawSubsystem::MakeHandle()
+{
+	// 0 is reserved for "no handle"
+	LastHandle = (LastHandle == MAX_int32) ? 1 : (LastHandle + 1);
+	return LastHandle;
+}
+
+bool UExtraDebugDrawSubsystem::GetViewLocations(TArray<FVector>& OutLocations) const
+{
+	const UWorld* const World = GetWorld();
+	if (World)
+	{
+		OutLocations = World->ViewLocationsRenderedLastFrame;
+	}
+	return OutLocations.Num() > 0;
+}
+
+bool UExtraDebugDrawSubsystem::HaveViewsMoved(const TArray<FVector>& ViewLocations) const
+{
+	if (ViewLocations.Num() != LastViewLocations.Num())
+	{
+		return true;
+	}
+
+	const float UpdateDistanceSquared = FMath::Square(CullUpdateDistance);
+	for (int32 index = 0; index < ViewLocations.Num(); index++)
+	{
+		if (FVector::DistSquared(ViewLocations[index], LastViewLocations[index]) > UpdateDistanceSquared)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void UExtraDebugDrawSubsystem::RebuildLines()
+{
+	bLinesDirty = false;
+	bUsesCulling = false;
+
+	UWorld* const World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	if (!LineBatcher)
+	{
+		if (Entries.Num() == 0)
+		{
+			return;
+		}
+		LineBatcher = NewObject<ULineBatchComponent>(this);
+		LineBatcher->bCalculateAccurateBounds = false;
+		LineBatcher->RegisterComponentWithWorld(World);
+	}
+
+	TArray<FVector> ViewLocations;
+	const bool bHasView = GetViewLocations(ViewLocations);
+	LastViewLocations = ViewLocations;
+
+	TArray<FBatchedLine> VisibleLines;
+	for (TPair<int32, FEntry>& Pair : Entries)
+	{
+		FEntry& Entry = Pair.Value;
+		Entry.bDrawn = true;
+		// What's in range changes as the view moves(or once there is a view)
+		bUsesCulling |= (Entry.CullDistance > 0.0f);
+		if (!bHasView || Entry.CullDistance <= 0.0f)
+		{
+			VisibleLines.Append(Entry.Lines);
+			continue;
+		}
+
+		const float CullDistanceSquared = FMath::Square(Entry.CullDistance);
+		for (int32 index = 0; index < Entry.ItemLocations.Num(); index++)
+		{
+			for (const FVector& ViewLocation : ViewLocations)
+			{
+				if (FVector::DistSquared(Entry.ItemLocations[index], ViewLocation) <= CullDistanceSquared)
+				{
+					VisibleLines.Append(Entry.Lines.GetData() + (index * Entry.LinesPerItem), Entry.LinesPerItem);
+					break;
+				}
+			}
+		}
+	}
+
+	// Lines with no lifetime stay until the next flush, expiring is handled by the entries
+	LineBatcher->Flush();
+	if (VisibleLines.Num() > 0)
+	{
+		LineBatcher->DrawLines(VisibleLines);
+	}
+}
@@ -1,4 +1,9 @@
 #include "ExtraFunctionality.h"
+#include "ExtraMemoryTracking.h"
+#include "ExtraPlatformProfile.h"
+#include "ExtraScalability.h"
+#include "Engine/Engine.h"
+#include "Misc/CoreDelegates.h"
 
 DEFINE_LOG_CATEGORY(ExtraFunctionality);
 
@@ -10,10 +15,31 @@ public:
 	virtual void StartupModule() override
 	{
 		UE_LOG(ExtraFunctionality, Display, TEXT("Extra Functionality Module Started"));
+
+		// Registered first so everything the plugin allocates lands under its tags
+		FExtraMemoryTracking::RegisterTags();
+		EXTRA_LLM_SCOPE(ExtraFunctionality);
+
+		FExtraPlatformProfiler::BuildProfile();
+		UE_LOG(ExtraFunctionality, Log, TEXT("Platform profile: %d worker threads, CPU score %.1f"),
+			FExtraPlatformProfiler::GetProfile().NumWorkerThreads, FExtraPlatformProfiler::GetProfile().CPUScore);
+
+		// The tier is picked now so subsystems start with its budgets, but the scalability level has to wait for the engine
+		FExtraScalability::AutoConfigure();
+		if (GEngine && GEngine->IsInitialized())
+		{
+			FExtraScalability::ApplyStartupScalabilityLevel();
+		}
+		else
+		{
+			PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddStatic(&FExtraScalability::ApplyStartupScalabilityLevel);
+		}
 	}
 
 	virtual void ShutdownModule() override
 	{
+		FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+		FExtraMemoryTracking::UnregisterTags();
 		UE_LOG(ExtraFunctionality, Display, TEXT("Extra Functionality Module Shutdown"));
 	}
 
@@ -22,6 +48,10 @@ public:
 		return true;
 	}
 
+private:
+
+	FDelegateHandle PostEngineInitHandle;
+
 };
 
 IMPLEMENT_MODULE(FExtraFunctionalityModule, ExtraFunctionality)
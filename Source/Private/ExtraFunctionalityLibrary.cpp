@@ -3,6 +3,8 @@
 #include "ExtraFunctionalityLibrary.h"
 #include "AudioDeviceManager.h"
 #include "AudioDevice.h"
+#include "Async/ParallelFor.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
 #include "Components/SceneComponent.h"
 #include "Components/Widget.h"
 #include "ConfigCacheIni.h"
@@ -11,19 +13,32 @@
 #include "EngineUtils.h"
 #include "Engine/Console.h"
 #include "Engine/Classes/GameFramework/GameMode.h"
+#include "ExtraMemoryTracking.h"
 #include "GenericPlatformMisc.h"
+#include "ExtraComponentLookup.h"
+#include "ExtraGroundHeightCache.h"
 #include "ExtraMathLibrary.h"
+#include "ExtraObjectHandles.h"
+#include "ExtraPlatformProfile.h"
+#include "ExtraRenderDirtyQueue.h"
+#include "ExtraScalability.h"
+#include "ExtraReplayCatalog.h"
+#include "ExtraSplineMeshBuilder.h"
 #include "ExtraWidgetLibrary.h"
 #include "Framework/Application/SlateApplication.h"
 #include "HAL/FileManager.h"
 #include "GameFramework/InputSettings.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "LatentActions.h"
+#include "Engine/LatentActionManager.h"
 #include "Kismet/KismetStringLibrary.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include "Kismet/GameplayStatics.h"
 #include "NetworkReplayStreaming/Public/NetworkReplayStreaming.h"
 #include "Engine/ObjectLibrary.h"
 #include "Paths.h"
+#include "Physics/PhysicsInterfaceCore.h"
+#include "PhysicsEngine/BodyInstance.h"
 #include "Runtime/Engine/Classes/Engine/DemoNetDriver.h"
 #include "Runtime/ApplicationCore/Public/HAL/PlatformApplicationMisc.h"
 #include "UMG/Public/Components/CheckBox.h"
@@ -67,6 +82,32 @@ FString UExtraFunctionalityLibrary::GetPlatformDeviceName()
 	return FPlatformMisc::GetDefaultDeviceProfileName();
 }
 
+FExtraPlatformProfile UExtraFunctionalityLibrary::GetPlatformProfile()
+{
+	return FExtraPlatformProfiler::GetProfile();
+}
+
+FExtraCPUBenchmarkResult UExtraFunctionalityLibrary::GetCPUBenchmarkResult()
+{
+	return FExtraScalability::GetResult();
+}
+
+FExtraCPUBenchmarkResult UExtraFunctionalityLibrary::RunCPUBenchmark(bool bApplyScalabilityLevel)
+{
+	FExtraScalability::RunBenchmark(true);
+	FExtraScalability::SelectTier();
+	if (bApplyScalabilityLevel)
+	{
+		FExtraScalability::ApplyScalabilityLevel();
+	}
+	return FExtraScalability::GetResult();
+}
+
+TArray<FExtraMemoryTagUsage> UExtraFunctionalityLibrary::GetMemoryTagUsage()
+{
+	return FExtraMemoryTracking::GetTagUsage();
+}
+
 EPlatformType UExtraFunctionalityLibrary::GetPlatformType()
 {
 #if (PLATFORM_XBOXONE || PLATFORM_PS4 || PLATFORM_SWITCH || PLATFORM_TVOS)
@@ -385,6 +426,7 @@ FString UExtraFunctionalityLibrary::GetLocalAppDataDirectory()
 
 TArray<FString> UExtraFunctionalityLibrary::GetSubDirectories(FString InDir, bool bDeepSearch)
 {			
+	EXTRA_LLM_SCOPE(Files);
 	// Turn it into a wildcard search
 	FString FinalPath = InDir / TEXT("*");
 
@@ -804,6 +846,241 @@ void UExtraFunctionalityLibrary::SetAngularVelocityInRadiansToComponentBody(cons
 	InComponent->GetBodyInstance()->SetAngularVelocityInRadians(NewAngVel, bAddToCurrent);
 }
 
+namespace ExtraBatchedPhysics
+{
+	/** Returns true if Values can be used with Components, either one value per component or a single value for all of them. */
+	static bool IsValidValueArray(const TArray<UPrimitiveComponent*>& Components, const TArray<FVector>& Values, const TCHAR* FunctionName)
+	{
+		if (Values.Num() == 1 || Values.Num() == Components.Num())
+		{
+			return true;
+		}
+		UE_LOG(LogExtraFunctionalityLibrary, Warning, TEXT("%s: Expected 1 or %d values but got %d, nothing was applied."), 
+			FunctionName, Components.Num(), Values.Num());
+		return false;
+	}
+
+	static FORCEINLINE const FVector& GetValue(const TArray<FVector>& Values, const int32 Index)
+	{
+		return (Values.Num() == 1) ? Values[0] : Values[Index];
+	}
+
+	/** The body instances of a batch that live in the same physics scene, paired with their index in the batch */
+	struct FSceneBodies
+	{
+		FPhysScene* Scene;
+		TArray<TPair<FBodyInstance*, int32>> Bodies;
+	};
+
+	/** Looks up every component's body instance once and groups them by physics scene. */
+	static void GatherSceneBodies(TArrayView<UPrimitiveComponent* const> Components, const bool bSimulatingOnly,
+		TArray<FSceneBodies, TInlineAllocator<1>>& OutSceneBodies)
+	{
+		for (int32 index = 0; index < Components.Num(); index++)
+		{
+			const UPrimitiveComponent* const Comp = Components[index];
+			if (!Comp || (bSimulatingOnly && !Comp->IsSimulatingPhysics()))
+			{
+				continue;
+			}
+
+			FBodyInstance* const Body = Comp->GetBodyInstance();
+			const UWorld* const World = Comp->GetWorld();
+			FPhysScene* const Scene = World ? World->GetPhysicsScene() : nullptr;
+			if (!Body || !Scene)
+			{
+				continue;
+			}
+
+			// Almost always a single scene, so a linear search beats a map
+			FSceneBodies* Found = OutSceneBodies.FindByPredicate([Scene](const FSceneBodies& Entry) { return Entry.Scene == Scene; });
+			if (!Found)
+			{
+				Found = &OutSceneBodies.AddDefaulted_GetRef();
+				Found->Scene = Scene;
+				Found->Bodies.Reserve(Components.Num() - index);
+			}
+			Found->Bodies.Emplace(Body, index);
+		}
+	}
+
+	/**
+	* Calls PerBody for each simulating component's body instance while holding the physics scene's write lock.
+	* The body instance functions called inside still lock, but since the scene lock is already held those are just re-entrant lock counts.
+	*/
+	template<typename FuncType>
+	static void ExecuteWriteOnBodies(const TArray<UPrimitiveComponent*>& Components, FuncType&& PerBody)
+	{
+		TArray<FSceneBodies, TInlineAllocator<1>> SceneBodies;
+		GatherSceneBodies(Components, true, SceneBodies);
+
+		for (const FSceneBodies& Entry : SceneBodies)
+		{
+			FPhysicsCommand::ExecuteWrite(Entry.Scene, [&Entry, &PerBody]()
+			{
+				for (const TPair<FBodyInstance*, int32>& Pair : Entry.Bodies)
+				{
+					PerBody(*Pair.Key, Pair.Value);
+				}
+			});
+		}
+	}
+}
+
+void UExtraFunctionalityLibrary::AddForceToComponentBodies(const TArray<UPrimitiveComponent*>& Components,
+	const TArray<FVector>& Forces, const bool bAccelChange)
+{
+	if (!ExtraBatchedPhysics::IsValidValueArray(Components, Forces, TEXT("AddForceToComponentBodies")))
+	{
+		return;
+	}
+	ExtraBatchedPhysics::ExecuteWriteOnBodies(Components, [&](FBodyInstance& Body, const int32 Index)
+	{
+		Body.AddForce(ExtraBatchedPhysics::GetValue(Forces, Index), false, bAccelChange);
+	});
+}
+
+void UExtraFunctionalityLibrary::AddForceAtPositionToComponentBodies(const TArray<UPrimitiveComponent*>& Components,
+	const TArray<FVector>& Forces, const TArray<FVector>& Positions, const bool bLocalSpace)
+{
+	if (!ExtraBatchedPhysics::IsValidValueArray(Components, Forces, TEXT("AddForceAtPositionToComponentBodies")) ||
+		!ExtraBatchedPhysics::IsValidValueArray(Components, Positions, TEXT("AddForceAtPositionToComponentBodies")))
+	{
+		return;
+	}
+	ExtraBatchedPhysics::ExecuteWriteOnBodies(Components, [&](FBodyInstance& Body, const int32 Index)
+	{
+		Body.AddForceAtPosition(ExtraBatchedPhysics::GetValue(Forces, Index), ExtraBatchedPhysics::GetValue(Positions, Index), false, bLocalSpace);
+	});
+}
+
+void UExtraFunctionalityLibrary::AddImpulseAtPositionToComponentBodies(const TArray<UPrimitiveComponent*>& Components,
+	const TArray<FVector>& Impulses, const TArray<FVector>& Positions)
+{
+	if (!ExtraBatchedPhysics::IsValidValueArray(Components, Impulses, TEXT("AddImpulseAtPositionToComponentBodies")) ||
+		!ExtraBatchedPhysics::IsValidValueArray(Components, Positions, TEXT("AddImpulseAtPositionToComponentBodies")))
+	{
+		return;
+	}
+	ExtraBatchedPhysics::ExecuteWriteOnBodies(Components, [&](FBodyInstance& Body, const int32 Index)
+	{
+		Body.AddImpulseAtPosition(ExtraBatchedPhysics::GetValue(Impulses, Index), ExtraBatchedPhysics::GetValue(Positions, Index));
+	});
+}
+
+void UExtraFunctionalityLibrary::AddImpulseToComponentBodies(const TArray<UPrimitiveComponent*>& Components,
+	const TArray<FVector>& Impulses, const bool bVelChange)
+{
+	if (!ExtraBatchedPhysics::IsValidValueArray(Components, Impulses, TEXT("AddImpulseToComponentBodies")))
+	{
+		return;
+	}
+	ExtraBatchedPhysics::ExecuteWriteOnBodies(Components, [&](FBodyInstance& Body, const int32 Index)
+	{
+		Body.AddImpulse(ExtraBatchedPhysics::GetValue(Impulses, Index), bVelChange);
+	});
+}
+
+void UExtraFunctionalityLibrary::AddTorqueInRadiansToComponentBodies(const TArray<UPrimitiveComponent*>& Components,
+	const TArray<FVector>& Torques, const bool bAccelChange)
+{
+	if (!ExtraBatchedPhysics::IsValidValueArray(Components, Torques, TEXT("AddTorqueInRadiansToComponentBodies")))
+	{
+		return;
+	}
+	ExtraBatchedPhysics::ExecuteWriteOnBodies(Components, [&](FBodyInstance& Body, const int32 Index)
+	{
+		Body.AddTorqueInRadians(ExtraBatchedPhysics::GetValue(Torques, Index), false, bAccelChange);
+	});
+}
+
+void UExtraFunctionalityLibrary::AddAngularImpulseInRadiansToComponentBodies(const TArray<UPrimitiveComponent*>& Components,
+	const TArray<FVector>& Impulses, const bool bVelChange)
+{
+	if (!ExtraBatchedPhysics::IsValidValueArray(Components, Impulses, TEXT("AddAngularImpulseInRadiansToComponentBodies")))
+	{
+		return;
+	}
+	ExtraBatchedPhysics::ExecuteWriteOnBodies(Components, [&](FBodyInstance& Body, const int32 Index)
+	{
+		Body.AddAngularImpulseInRadians(ExtraBatchedPhysics::GetValue(Impulses, Index), bVelChange);
+	});
+}
+
+void UExtraFunctionalityLibrary::SetLinearVelocityToComponentBodies(const TArray<UPrimitiveComponent*>& Components,
+	const TArray<FVector>& NewVels, const bool bAddToCurrent)
+{
+	if (!ExtraBatchedPhysics::IsValidValueArray(Components, NewVels, TEXT("SetLinearVelocityToComponentBodies")))
+	{
+		return;
+	}
+	ExtraBatchedPhysics::ExecuteWriteOnBodies(Components, [&](FBodyInstance& Body, const int32 Index)
+	{
+		Body.SetLinearVelocity(ExtraBatchedPhysics::GetValue(NewVels, Index), bAddToCurrent);
+	});
+}
+
+void UExtraFunctionalityLibrary::SetAngularVelocityInRadiansToComponentBodies(const TArray<UPrimitiveComponent*>& Components,
+	const TArray<FVector>& NewAngVels, const bool bAddToCurrent)
+{
+	if (!ExtraBatchedPhysics::IsValidValueArray(Components, NewAngVels, TEXT("SetAngularVelocityInRadiansToComponentBodies")))
+	{
+		return;
+	}
+	ExtraBatchedPhysics::ExecuteWriteOnBodies(Components, [&](FBodyInstance& Body, const int32 Index)
+	{
+		Body.SetAngularVelocityInRadians(ExtraBatchedPhysics::GetValue(NewAngVels, Index), bAddToCurrent);
+	});
+}
+
+void UExtraFunctionalityLibrary::GetComponentBodyStates(const TArray<UPrimitiveComponent*>& Components, FExtraRigidBodyStates& OutStates)
+{
+	ReadComponentBodyStates(Components, OutStates);
+}
+
+void UExtraFunctionalityLibrary::ReadComponentBodyStates(TArrayView<UPrimitiveComponent* const> Components, FExtraRigidBodyStates& OutStates)
+{
+	const int32 Num = Components.Num();
+	OutStates.Locations.SetNumZeroed(Num);
+	OutStates.Rotations.SetNumZeroed(Num);
+	OutStates.LinearVelocities.SetNumZeroed(Num);
+	OutStates.AngularVelocitiesInRadians.SetNumZeroed(Num);
+	OutStates.bIsSleeping.Init(false, Num);
+	OutStates.bHasBody.Init(false, Num);
+
+	TArray<ExtraBatchedPhysics::FSceneBodies, TInlineAllocator<1>> SceneBodies;
+	ExtraBatchedPhysics::GatherSceneBodies(Components, false, SceneBodies);
+
+	for (const ExtraBatchedPhysics::FSceneBodies& Entry : SceneBodies)
+	{
+		// Reads straight from the physics actors since the lock is already held, instead of going through the body instance getters which each lock
+		FPhysicsCommand::ExecuteRead(Entry.Scene, [&Entry, &OutStates]()
+		{
+			for (const TPair<FBodyInstance*, int32>& Pair : Entry.Bodies)
+			{
+				const FPhysicsActorHandle& Handle = Pair.Key->GetPhysicsActorHandle();
+				if (!FPhysicsInterface::IsValid(Handle))
+				{
+					continue;
+				}
+
+				const int32 Index = Pair.Value;
+				const FTransform Pose = FPhysicsInterface::GetGlobalPose_AssumesLocked(Handle);
+				OutStates.Locations[Index] = Pose.GetLocation();
+				OutStates.Rotations[Index] = Pose.Rotator();
+				OutStates.bHasBody[Index] = true;
+
+				if (FPhysicsInterface::IsRigidBody(Handle))
+				{
+					OutStates.LinearVelocities[Index] = FPhysicsInterface::GetLinearVelocity_AssumesLocked(Handle);
+					OutStates.AngularVelocitiesInRadians[Index] = FPhysicsInterface::GetAngularVelocity_AssumesLocked(Handle);
+					OutStates.bIsSleeping[Index] = FPhysicsInterface::IsSleeping(Handle);
+				}
+			}
+		});
+	}
+}
+
 FVector UExtraFunctionalityLibrary::GetSocketRelativeLocation(USceneComponent * Target, FName InSocketName)
 {
 	if (Target)
@@ -846,7 +1123,7 @@ bool UExtraFunctionalityLibrary::MarkRenderDirty(USceneComponent * InComp)
 	return true;
 }
 
-bool UExtraFunctionalityLibrary::AreObjectsValid(TArray<UObject*> Objects)
+bool UExtraFunctionalityLibrary::AreObjectsValid(const TArray<UObject*>& Objects)
 {
 	if (Objects.Num() == 0)
 	{
@@ -866,24 +1143,106 @@ bool UExtraFunctionalityLibrary::AreObjectsValid(TArray<UObject*> Objects)
 	return true;
 }
 
+TArray<FExtraObjectHandle> UExtraFunctionalityLibrary::MakeObjectHandles(const TArray<UObject*>& Objects)
+{
+	TArray<FExtraObjectHandle> Handles;
+	Handles.Reserve(Objects.Num());
+	UExtraObjectHandleSubsystem* const HandleTable = UExtraObjectHandleSubsystem::Get();
+	for (UObject* const Object : Objects)
+	{
+		Handles.Add(HandleTable ? HandleTable->MakeHandle(Object) : FExtraObjectHandle());
+	}
+	return Handles;
+}
+
+namespace ExtraOverlap
+{
+	/** Bit per collision channel of the object types to accept, 0 accepts every object type */
+	static uint32 MakeObjectTypeMask(const TArray<TEnumAsByte<EObjectTypeQuery>>& ObjectTypes)
+	{
+		uint32 Mask = 0;
+		for (const TEnumAsByte<EObjectTypeQuery>& ObjectType : ObjectTypes)
+		{
+			Mask |= ECC_TO_BITFIELD(UEngineTypes::ConvertToCollisionChannel(ObjectType));
+		}
+		return Mask;
+	}
+
+	/** Walks the component's overlaps in place and stops at the first one that passes the filters. */
+	static bool HasMatchingOverlap(const UPrimitiveComponent* InComp, const UClass* ActorClass, const uint32 ObjectTypeMask, const bool bExcludeSelf)
+	{
+		const AActor* const Owner = InComp->GetOwner();
+		for (const FOverlapInfo& Overlap : InComp->GetOverlapInfos())
+		{
+			const UPrimitiveComponent* const OtherComp = Overlap.OverlapInfo.Component.Get();
+			const AActor* const OtherActor = OtherComp ? OtherComp->GetOwner() : nullptr;
+			if (!OtherActor || (bExcludeSelf && OtherActor == Owner))
+			{
+				continue;
+			}
+			if (ActorClass && !OtherActor->IsA(ActorClass))
+			{
+				continue;
+			}
+			if (ObjectTypeMask != 0 && (ObjectTypeMask & ECC_TO_BITFIELD(OtherComp->GetCollisionObjectType())) == 0)
+			{
+				continue;
+			}
+			return true;
+		}
+		return false;
+	}
+}
+
 bool UExtraFunctionalityLibrary::IsOverlappingAnyActors(UPrimitiveComponent * InComp, bool bExcludeSelf)
 {
 	// Valid check
 	if (InComp)
-	{		
-		TArray<AActor*> FoundActors;
-		InComp->GetOverlappingActors(FoundActors);
+	{
+		return ExtraOverlap::HasMatchingOverlap(InComp, nullptr, 0, bExcludeSelf);
+	}
+	return false;
+}
+
+bool UExtraFunctionalityLibrary::IsOverlappingAnyActorsFiltered(UPrimitiveComponent * InComp, TSubclassOf<AActor> ActorClass,
+	const TArray<TEnumAsByte<EObjectTypeQuery>>& ObjectTypes, bool bExcludeSelf)
+{
+	if (InComp)
+	{
+		return ExtraOverlap::HasMatchingOverlap(InComp, ActorClass, ExtraOverlap::MakeObjectTypeMask(ObjectTypes), bExcludeSelf);
+	}
+	return false;
+}
+
+int32 UExtraFunctionalityLibrary::AreOverlappingAnyActors(const TArray<UPrimitiveComponent*>& InComps, TArray<bool>& Results,
+	TSubclassOf<AActor> ActorClass, const TArray<TEnumAsByte<EObjectTypeQuery>>& ObjectTypes, bool bExcludeSelf)
+{
+	const uint32 ObjectTypeMask = ExtraOverlap::MakeObjectTypeMask(ObjectTypes);
+	int32 NumOverlapping = 0;
+	Results.SetNumUninitialized(InComps.Num());
+	for (int32 index = 0; index < InComps.Num(); index++)
+	{
+		Results[index] = InComps[index] && ExtraOverlap::HasMatchingOverlap(InComps[index], ActorClass, ObjectTypeMask, bExcludeSelf);
+		NumOverlapping += Results[index];
+	}
+	return NumOverlapping;
+}
 
-		// Remove the component's actor
-		if (bExcludeSelf)
+int32 UExtraFunctionalityLibrary::AreOverlappingAnyActorsBits(TArrayView<UPrimitiveComponent* const> InComps, TBitArray<>& Results,
+	TSubclassOf<AActor> ActorClass, const TArray<TEnumAsByte<EObjectTypeQuery>>& ObjectTypes, bool bExcludeSelf)
+{
+	const uint32 ObjectTypeMask = ExtraOverlap::MakeObjectTypeMask(ObjectTypes);
+	int32 NumOverlapping = 0;
+	Results.Init(false, InComps.Num());
+	for (int32 index = 0; index < InComps.Num(); index++)
+	{
+		if (InComps[index] && ExtraOverlap::HasMatchingOverlap(InComps[index], ActorClass, ObjectTypeMask, bExcludeSelf))
 		{
-			FoundActors.Remove(InComp->GetOwner());
+			Results[index] = true;
+			NumOverlapping++;
 		}
-
-		// Check that the array isn't empty
-		return (FoundActors.Num() > 0);
 	}
-	return false;
+	return NumOverlapping;
 }
 
 int UExtraFunctionalityLibrary::GetNumberOfActorsOfType(const UObject * WorldContextObject, TSubclassOf<AActor> SearchClass)
@@ -940,7 +1299,7 @@ void UExtraFunctionalityLibrary::FindComponentOfClass(AActor * InActor, TSubclas
 	FoundComponent = nullptr;
 	if (ComponentClass && InActor)
 	{
-		if (UActorComponent* Comp = InActor->GetComponentByClass(ComponentClass))
+		if (UActorComponent* Comp = UExtraComponentLookupSubsystem::FindComponentByClass(InActor, ComponentClass))
 		{
 			FoundComponent = Comp;
 			Result = EExtraSwitch::OnSucceeded;
@@ -948,7 +1307,23 @@ void UExtraFunctionalityLibrary::FindComponentOfClass(AActor * InActor, TSubclas
 	}
 }
 
-void UExtraFunctionalityLibrary::MarkRenderDity_Comps(TArray<USceneComponent*> InComps)
+int32 UExtraFunctionalityLibrary::FindComponentsOfClass(AActor * InActor, TSubclassOf<UActorComponent> ComponentClass, TArray<UActorComponent*>& FoundComponents)
+{
+	FoundComponents.Reset();
+	if (!ComponentClass || !InActor)
+	{
+		return 0;
+	}
+
+	if (UExtraComponentLookupSubsystem* const Subsystem = UExtraComponentLookupSubsystem::Get(InActor))
+	{
+		return Subsystem->FindComponentsOfClass(InActor, ComponentClass, FoundComponents);
+	}
+	FoundComponents = InActor->GetComponentsByClass(ComponentClass);
+	return FoundComponents.Num();
+}
+
+void UExtraFunctionalityLibrary::MarkRenderDity_Comps(const TArray<USceneComponent*>& InComps)
 {
 	for (USceneComponent* Comp : InComps)
 	{
@@ -956,6 +1331,42 @@ void UExtraFunctionalityLibrary::MarkRenderDity_Comps(TArray<USceneComponent*> I
 	}
 }
 
+namespace ExtraRenderDirty
+{
+	/** The DirtyFlags default of the deferred render dirty functions, which has to be a literal in their declarations */
+	static const int32 DefaultFlags = 7;
+	static_assert(DefaultFlags == (int32)EExtraRenderDirtyFlags::All, "The DirtyFlags defaults of MarkRenderDirtyDeferred need to be updated to EExtraRenderDirtyFlags::All");
+}
+
+bool UExtraFunctionalityLibrary::MarkRenderDirtyDeferred(USceneComponent* InComp, int32 DirtyFlags)
+{
+	UExtraRenderDirtyQueueSubsystem* const Queue = UExtraRenderDirtyQueueSubsystem::Get(InComp);
+	if (!Queue)
+	{
+		return false;
+	}
+
+	Queue->QueueRenderDirty(InComp, (EExtraRenderDirtyFlags)DirtyFlags);
+	return true;
+}
+
+void UExtraFunctionalityLibrary::MarkRenderDirtyDeferred_Comps(const TArray<USceneComponent*>& InComps, int32 DirtyFlags)
+{
+	UExtraRenderDirtyQueueSubsystem* Queue = nullptr;
+	for (USceneComponent* Comp : InComps)
+	{
+		// Every component is most likely in the same world so only look the queue up once
+		if (Comp && (!Queue || Queue->GetWorld() != Comp->GetWorld()))
+		{
+			Queue = UExtraRenderDirtyQueueSubsystem::Get(Comp);
+		}
+		if (Comp && Queue)
+		{
+			Queue->QueueRenderDirty(Comp, (EExtraRenderDirtyFlags)DirtyFlags);
+		}
+	}
+}
+
 FVector2D UExtraFunctionalityLibrary::GetDirectionalInputsFromDirectionalKeys(const APlayerController * InPlayerController,
 	const FKey UpDirectional, const FKey DownDirectional, const FKey RightDirectional, const FKey LeftDirectional)
 {
@@ -1124,18 +1535,13 @@ bool UExtraFunctionalityLibrary::Equals_InputActionKeyMapping(FInputActionKeyMap
 bool UExtraFunctionalityLibrary::FindSceneComponentByName(AActor * ActorToSearchIn,
 	const FString & CompName, USceneComponent *& FoundComp)
 {
-	if (ActorToSearchIn && !CompName.IsEmpty())
+	UActorComponent* Comp = nullptr;
+	if (FindActorComponentByName(ActorToSearchIn, CompName, Comp))
 	{
-		for (UActorComponent* Comp : ActorToSearchIn->GetComponents())
+		if (USceneComponent* SComp = Cast<USceneComponent>(Comp))
 		{
-			if (USceneComponent* SComp = Cast<USceneComponent>(Comp))
-			{
-				if (GetNameSafe(SComp) == CompName)
-				{
-					FoundComp = SComp;
-					return true;
-				}
-			}
+			FoundComp = SComp;
+			return true;
 		}
 	}
 	return false;
@@ -1146,18 +1552,46 @@ bool UExtraFunctionalityLibrary::FindActorComponentByName(AActor* ActorToSearchI
 {
 	if (ActorToSearchIn && !CompName.IsEmpty())
 	{
-		for (UActorComponent* Comp : ActorToSearchIn->GetComponents())
+		// If the name was never made then no component can have it
+		const FName SearchName(*CompName, FNAME_Find);
+		if (!SearchName.IsNone())
 		{
-			if (GetNameSafe(Comp) == CompName)
-			{
-				FoundComp = Comp;
-				return true;
-			}
+			return FindActorComponentByFName(ActorToSearchIn, SearchName, FoundComp);
 		}
 	}
 	return false;
 }
 
+bool UExtraFunctionalityLibrary::FindActorComponentByFName(AActor* ActorToSearchIn,
+	FName CompName, UActorComponent*& FoundComp)
+{
+	if (UActorComponent* Comp = UExtraComponentLookupSubsystem::FindComponentByName(ActorToSearchIn, CompName))
+	{
+		FoundComp = Comp;
+		return true;
+	}
+	return false;
+}
+
+int32 UExtraFunctionalityLibrary::FindActorComponentsByNames(AActor* ActorToSearchIn,
+	const TArray<FName>& CompNames, TArray<UActorComponent*>& FoundComps)
+{
+	if (UExtraComponentLookupSubsystem* const Subsystem = UExtraComponentLookupSubsystem::Get(ActorToSearchIn))
+	{
+		return Subsystem->FindComponents(ActorToSearchIn, CompNames, FoundComps);
+	}
+
+	int32 NumFound = 0;
+	FoundComps.Reset(CompNames.Num());
+	for (const FName& CompName : CompNames)
+	{
+		UActorComponent* const Comp = UExtraComponentLookupSubsystem::FindComponentByName(ActorToSearchIn, CompName);
+		FoundComps.Add(Comp);
+		NumFound += (Comp != nullptr);
+	}
+	return NumFound;
+}
+
 UPrimitiveComponent * UExtraFunctionalityLibrary::GetClosestComponentToPoint(TArray<UPrimitiveComponent*> Comps, 
 	FVector Point, bool Inverse)
 {
@@ -1244,13 +1678,53 @@ void UExtraFunctionalityLibrary::DrawDebugCoordinateArrowsAtComponent(USceneComp
 #endif
 }
 
+namespace ExtraGroundSnap
+{
+	/** 
+	* Tries to find the ground below StartLoc using the world's ground height cache. 
+	* Fails if the cached ground is above StartLoc or further than TraceDistance below it, so the caller can fall back to tracing.
+	*/
+	static bool FindCachedGround(UWorld* World, const FVector& StartLoc, float TraceDistance, ETraceTypeQuery TraceChannel, bool bTraceComplex, FVector& OutGroundLoc)
+	{
+		UExtraGroundHeightCacheSubsystem* const Cache = World->GetSubsystem<UExtraGroundHeightCacheSubsystem>();
+		float GroundHeight = 0.0f;
+		if (!Cache || !Cache->GetGroundHeight(StartLoc, TraceChannel, bTraceComplex, GroundHeight))
+		{
+			return false;
+		}
+
+		if (GroundHeight > StartLoc.Z || GroundHeight < (StartLoc.Z - TraceDistance))
+		{
+			return false;
+		}
+
+		OutGroundLoc = FVector(StartLoc.X, StartLoc.Y, GroundHeight);
+		return true;
+	}
+}
+
 bool UExtraFunctionalityLibrary::SnapActorToGround(AActor * InActor, float TraceDistance, bool bTraceComplex, ETraceTypeQuery GroundChannel,
-	const TArray<AActor*>& ActorsToIgnore, FVector OptionalOffset, bool bDrawDebug, FLinearColor TraceColor, FLinearColor TraceHitColor, float DrawDebugTime)
+	const TArray<AActor*>& ActorsToIgnore, FVector OptionalOffset, bool bDrawDebug, FLinearColor TraceColor, FLinearColor TraceHitColor, float DrawDebugTime,
+	bool bUseGroundHeightCache)
 {
 	if (InActor)
 	{
 		if (UWorld* World = GEngine->GetWorldFromContextObject(InActor, EGetWorldErrorMode::LogAndReturnNull))
 		{
+			FVector CachedGroundLoc;
+			if (bUseGroundHeightCache && 
+				ExtraGroundSnap::FindCachedGround(World, InActor->GetActorLocation(), TraceDistance, GroundChannel, bTraceComplex, CachedGroundLoc))
+			{
+				InActor->SetActorLocation(CachedGroundLoc + OptionalOffset);
+#if ENABLE_DRAW_DEBUG
+				if (bDrawDebug)
+				{
+					DrawDebugPoint(World, CachedGroundLoc, 16.0f, TraceHitColor.ToFColor(true), false, DrawDebugTime); // Cached ground point
+				}
+#endif
+				return true;
+			}
+
 			// Setup the variables to use for the trace
 			ECollisionChannel CollisionChannel = UEngineTypes::ConvertToCollisionChannel(GroundChannel);
 			FCollisionQueryParams Params;
@@ -1292,6 +1766,179 @@ bool UExtraFunctionalityLibrary::SnapActorToGround(AActor * InActor, float Trace
 	return false;
 }
 
+/** 
+* Waits on the async ground traces issued by SnapActorsToGround, then moves every hit actor in one pass.
+* Traces are issued in batches of the scalability tier's traces per frame, or all at once if it has no limit.
+*/
+class FExtraSnapActorsToGroundAction : public FPendingLatentAction
+{
+public:
+
+	FExtraSnapActorsToGroundAction(UWorld* InWorld, const TArray<AActor*>& InActors, float TraceDistance, bool bTraceComplex,
+		ETraceTypeQuery GroundChannel, const TArray<AActor*>& ActorsToIgnore, const FVector& InOffset, TArray<bool>& InSnappedActors,
+		const FLatentActionInfo& LatentInfo)
+		: World(InWorld)
+		, Offset(InOffset)
+		, BaseParams(SCENE_QUERY_STAT(ExtraSnapActorsToGround), bTraceComplex)
+		, CollisionChannel(UEngineTypes::ConvertToCollisionChannel(GroundChannel))
+		, TraceOffset(FVector(0.0f, 0.0f, -1.0f) * TraceDistance)
+		, NextTraceIndex(0)
+		, TracesPerFrame(FExtraScalability::GetTracesPerFrame(0))
+		, SnappedActors(InSnappedActors)
+		, ExecutionFunction(LatentInfo.ExecutionFunction)
+		, OutputLink(LatentInfo.Linkage)
+		, CallbackTarget(LatentInfo.CallbackTarget)
+	{
+		SnappedActors.Init(false, InActors.Num());
+		Actors.Append(InActors);
+		TraceHandles.SetNum(InActors.Num());
+
+		// Built once, each trace only has to add its own actor on top of this
+		BaseParams.AddIgnoredActors(ActorsToIgnore);
+
+		IssueTraces();
+	}
+
+	virtual void UpdateOperation(FLatentResponse& Response) override
+	{
+		if (!World.IsValid())
+		{
+			Response.DoneIf(true);
+			return;
+		}
+
+		// Gather what finished this frame, traces that aren't done stay in the pending handles
+		FTraceDatum Datum;
+		bool bAllFinished = true;
+		for (int32 index = TraceHandles.Num(); index-- > 0;)
+		{
+			if (!TraceHandles[index].IsValid())
+			{
+				continue;
+			}
+
+			if (World->QueryTraceData(TraceHandles[index], Datum))
+			{
+				TraceHandles[index].Invalidate();
+				if (Datum.OutHits.Num() > 0 && Datum.OutHits[0].bBlockingHit)
+				{
+					HitLocations.Emplace(index, Datum.OutHits[0].ImpactPoint);
+				}
+			}
+			else if (World->IsTraceHandleValid(TraceHandles[index], false))
+			{
+				bAllFinished = false;
+			}
+			else
+			{
+				// The trace data was flushed without us seeing it, count it as a miss
+				TraceHandles[index].Invalidate();
+			}
+		}
+
+		if (NextTraceIndex < Actors.Num())
+		{
+			IssueTraces();
+			bAllFinished = false;
+		}
+
+		if (bAllFinished)
+		{
+			ApplyLocations();
+		}
+		Response.FinishAndTriggerIf(bAllFinished, ExecutionFunction, OutputLink, CallbackTarget);
+	}
+
+#if WITH_EDITOR
+	virtual FString GetDescription() const override
+	{
+		return FString::Printf(TEXT("Snapping %d actors to ground"), Actors.Num());
+	}
+#endif
+
+private:
+
+	void IssueTraces()
+	{
+		UWorld* const TraceWorld = World.Get();
+		const int32 LastTraceIndex = (TracesPerFrame > 0) ? FMath::Min(NextTraceIndex + TracesPerFrame, Actors.Num()) : Actors.Num();
+		for (; NextTraceIndex < LastTraceIndex; NextTraceIndex++)
+		{
+			AActor* const Actor = Actors[NextTraceIndex].Get();
+			if (!Actor || !TraceWorld)
+			{
+				continue;
+			}
+
+			FCollisionQueryParams Params = BaseParams;
+			Params.AddIgnoredActor(Actor);
+
+			const FVector StartLoc = Actor->GetActorLocation();
+			TraceHandles[NextTraceIndex] = TraceWorld->AsyncLineTraceByChannel(EAsyncTraceType::Single, StartLoc, StartLoc + TraceOffset,
+				CollisionChannel, Params, FCollisionResponseParams::DefaultResponseParam, nullptr, NextTraceIndex);
+		}
+	}
+
+	void ApplyLocations()
+	{
+		// Defer every move so overlaps and child transforms are updated once per actor when the scopes end
+		TArray<TUniquePtr<FScopedMovementUpdate>> MovementScopes;
+		MovementScopes.Reserve(HitLocations.Num());
+
+		for (const TPair<int32, FVector>& Hit : HitLocations)
+		{
+			AActor* const Actor = Actors[Hit.Key].Get();
+			if (!Actor || !Actor->GetRootComponent())
+			{
+				continue;
+			}
+
+			MovementScopes.Add(MakeUnique<FScopedMovementUpdate>(Actor->GetRootComponent(), EScopedUpdate::DeferredUpdates));
+			Actor->SetActorLocation(Hit.Value + Offset);
+			SnappedActors[Hit.Key] = true;
+		}
+
+		// Scopes have to end in the reverse order they were made
+		for (int32 index = MovementScopes.Num(); index-- > 0;)
+		{
+			MovementScopes[index].Reset();
+		}
+	}
+
+	TWeakObjectPtr<UWorld> World;
+	TArray<TWeakObjectPtr<AActor>> Actors;
+	TArray<FTraceHandle> TraceHandles;
+	TArray<TPair<int32, FVector>> HitLocations;
+	FVector Offset;
+	FCollisionQueryParams BaseParams;
+	ECollisionChannel CollisionChannel;
+	FVector TraceOffset;
+	/** Index of the next actor to trace for */
+	int32 NextTraceIndex;
+	int32 TracesPerFrame;
+	TArray<bool>& SnappedActors;
+
+	FName ExecutionFunction;
+	int32 OutputLink;
+	FWeakObjectPtr CallbackTarget;
+};
+
+void UExtraFunctionalityLibrary::SnapActorsToGround(const UObject* WorldContextObject, const TArray<AActor*>& Actors, float TraceDistance, bool bTraceComplex,
+	ETraceTypeQuery GroundChannel, const TArray<AActor*>& ActorsToIgnore, FVector OptionalOffset, TArray<bool>& SnappedActors,
+	FLatentActionInfo LatentInfo)
+{
+	if (UWorld* const World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		FLatentActionManager& LatentManager = World->GetLatentActionManager();
+		if (!LatentManager.FindExistingAction<FExtraSnapActorsToGroundAction>(LatentInfo.CallbackTarget, LatentInfo.UUID))
+		{
+			LatentManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID,
+				new FExtraSnapActorsToGroundAction(World, Actors, TraceDistance, bTraceComplex, GroundChannel,
+					ActorsToIgnore, OptionalOffset, SnappedActors, LatentInfo));
+		}
+	}
+}
+
 float UExtraFunctionalityLibrary::SetSplineMeshRelativeRoll(USplineComponent* SplineComp, 
 	const FRotator RelativeRotation, const float DistanceAlongSpline, const bool bReturnInRadians)
 {
@@ -1329,7 +1976,7 @@ int32 UExtraFunctionalityLibrary::GetLastSplinePoint(USplineComponent * SplineCo
 
 void UExtraFunctionalityLibrary::SnapAllSplinePointsToGround(USplineComponent* SplineComp, float TraceDistance, bool bTraceComplex,
 	ETraceTypeQuery TraceChannel, const TArray<AActor*>& ActorsToIgnore, bool bDrawDebug,
-	FLinearColor TraceColor, FLinearColor TraceHitColor, float DrawDebugTime)
+	FLinearColor TraceColor, FLinearColor TraceHitColor, float DrawDebugTime, bool bUseGroundHeightCache)
 {
 	if (!SplineComp)
 	{
@@ -1355,6 +2002,20 @@ void UExtraFunctionalityLibrary::SnapAllSplinePointsToGround(USplineComponent* S
 			StartLoc = SplineComp->GetLocationAtSplinePoint(index, ESplineCoordinateSpace::World);
 			EndLoc = (StartLoc + (FVector(0.0f, 0.0f, -1.0f) * TraceDistance));
 
+			FVector CachedGroundLoc;
+			if (bUseGroundHeightCache && 
+				ExtraGroundSnap::FindCachedGround(World, StartLoc, TraceDistance, TraceChannel, bTraceComplex, CachedGroundLoc))
+			{
+				SplineComp->SetLocationAtSplinePoint(index, CachedGroundLoc, ESplineCoordinateSpace::World);
+#if ENABLE_DRAW_DEBUG
+				if (bDrawDebug)
+				{
+					DrawDebugPoint(World, CachedGroundLoc, 16.0f, TraceHitColor.ToFColor(true), false, DrawDebugTime); // Cached ground point
+				}
+#endif
+				continue;
+			}
+
 			// Trace
 			if (World->LineTraceSingleByChannel(Hit, StartLoc, EndLoc, CollisionChannel, Params))
 			{
@@ -1385,7 +2046,8 @@ void UExtraFunctionalityLibrary::SnapAllSplinePointsToGround(USplineComponent* S
 
 void UExtraFunctionalityLibrary::SnapSingleSplinePointToGround(USplineComponent * SplineComp,
 	int32 SplinePointToSnap, float TraceDistance, bool bTraceComplex, ETraceTypeQuery TraceChannel, 
-	const TArray<AActor*>& ActorsToIgnore, bool bDrawDebug, FLinearColor TraceColor, FLinearColor TraceHitColor, float DrawDebugTime)
+	const TArray<AActor*>& ActorsToIgnore, bool bDrawDebug, FLinearColor TraceColor, FLinearColor TraceHitColor, float DrawDebugTime,
+	bool bUseGroundHeightCache)
 {
 	if (!SplineComp)
 	{
@@ -1395,6 +2057,20 @@ void UExtraFunctionalityLibrary::SnapSingleSplinePointToGround(USplineComponent
 	{
 		if (UWorld* World = GEngine->GetWorldFromContextObject(SplineComp, EGetWorldErrorMode::LogAndReturnNull))
 		{
+			FVector CachedGroundLoc;
+			if (bUseGroundHeightCache && ExtraGroundSnap::FindCachedGround(World, 
+				SplineComp->GetLocationAtSplinePoint(SplinePointToSnap, ESplineCoordinateSpace::World), TraceDistance, TraceChannel, bTraceComplex, CachedGroundLoc))
+			{
+				SplineComp->SetLocationAtSplinePoint(SplinePointToSnap, CachedGroundLoc, ESplineCoordinateSpace::World);
+#if ENABLE_DRAW_DEBUG
+				if (bDrawDebug)
+				{
+					DrawDebugPoint(World, CachedGroundLoc, 16.0f, TraceHitColor.ToFColor(true), false, DrawDebugTime); // Cached ground point
+				}
+#endif
+				return;
+			}
+
 			// Setup the variables to use in the for loop so we're not creating some of these variables for each loop iteration
 			ECollisionChannel CollisionChannel = UEngineTypes::ConvertToCollisionChannel(TraceChannel);
 			FCollisionQueryParams Params;
@@ -1523,144 +2199,509 @@ void UExtraFunctionalityLibrary::FindLocationAndRotationAtSplineInputKey(FVector
 	}	
 }
 
+namespace ExtraBulkSpline
+{
+	/** Below this many values it's faster to stay on the calling thread than to wake up workers */
+	static const int32 MinValuesForParallel = 256;
+	/** Fewest values evaluated per worker task, so each task does enough work to be worth scheduling */
+	static const int32 MinValuesPerBatch = 64;
+}
+
+void UExtraFunctionalityLibrary::FindTransformsAtSplineInputKeys(USplineComponent* SplineComp, const TArray<float>& InKeys,
+	ESplineCoordinateSpace::Type CoordinateSpace, FExtraSplineTransforms& OutTransforms)
+{
+	EvaluateSplineTransforms(SplineComp, InKeys, false, CoordinateSpace, OutTransforms);
+}
+
+void UExtraFunctionalityLibrary::FindTransformsAtDistancesAlongSpline(USplineComponent* SplineComp, const TArray<float>& Distances,
+	ESplineCoordinateSpace::Type CoordinateSpace, FExtraSplineTransforms& OutTransforms)
+{
+	EvaluateSplineTransforms(SplineComp, Distances, true, CoordinateSpace, OutTransforms);
+}
+
+void UExtraFunctionalityLibrary::EvaluateSplineTransforms(const USplineComponent* SplineComp, TArrayView<const float> Values, bool bValuesAreDistances,
+	ESplineCoordinateSpace::Type CoordinateSpace, FExtraSplineTransforms& OutTransforms)
+{
+	EXTRA_LLM_SCOPE(Splines);
+	const int32 NumValues = SplineComp ? Values.Num() : 0;
+	OutTransforms.Locations.SetNumUninitialized(NumValues);
+	OutTransforms.Rotations.SetNumUninitialized(NumValues);
+	OutTransforms.UpVectors.SetNumUninitialized(NumValues);
+	OutTransforms.RightVectors.SetNumUninitialized(NumValues);
+	OutTransforms.Scales.SetNumUninitialized(NumValues);
+
+	if (NumValues == 0)
+	{
+		return;
+	}
+
+	// Everything is evaluated in local space and the component transform is only fetched once for all of the values
+	const bool bWorldSpace = (CoordinateSpace == ESplineCoordinateSpace::World);
+	const FTransform ComponentTransform = bWorldSpace ? SplineComp->GetComponentTransform() : FTransform::Identity;
+	const FQuat ComponentRotation = ComponentTransform.GetRotation();
+	const FSplineCurves& Curves = SplineComp->SplineCurves;
+
+	const int32 BatchSize = FExtraPlatformProfiler::GetBatchSize(NumValues, ExtraBulkSpline::MinValuesPerBatch);
+	const int32 NumBatches = FMath::DivideAndRoundUp(NumValues, BatchSize);
+	ParallelFor(NumBatches, [&](int32 BatchIndex)
+	{
+		const int32 FirstIndex = BatchIndex * BatchSize;
+		const int32 LastIndex = FMath::Min(FirstIndex + BatchSize, NumValues);
+		for (int32 index = FirstIndex; index < LastIndex; index++)
+		{
+			const float InKey = bValuesAreDistances ? Curves.ReparamTable.Eval(Values[index], 0.0f) : Values[index];
+
+			FVector Location = SplineComp->GetLocationAtSplineInputKey(InKey, ESplineCoordinateSpace::Local);
+			FQuat Rotation = SplineComp->GetQuaternionAtSplineInputKey(InKey, ESplineCoordinateSpace::Local);
+			if (bWorldSpace)
+			{
+				Location = ComponentTransform.TransformPosition(Location);
+				Rotation = ComponentRotation * Rotation;
+			}
+
+			OutTransforms.Locations[index] = Location;
+			OutTransforms.Rotations[index] = Rotation.Rotator();
+			OutTransforms.UpVectors[index] = Rotation.GetUpVector();
+			OutTransforms.RightVectors[index] = Rotation.GetRightVector();
+			OutTransforms.Scales[index] = SplineComp->GetScaleAtSplineInputKey(InKey);
+		}
+	}, FExtraPlatformProfiler::ShouldForceSingleThread(NumValues, ExtraBulkSpline::MinValuesForParallel));
+}
+
 TArray<USplineMeshComponent*> UExtraFunctionalityLibrary::BuildSplineMeshesAlongSpline(
 	USplineComponent* SplineComp, FExtraSplineConstructionInfo ConstructionInfo)
 {
+	EXTRA_LLM_SCOPE(SplineMeshes);
 	if (!SplineComp || !ConstructionInfo.SplineMesh)
 	{
 		return TArray<USplineMeshComponent*>();
 	}
 	TArray<USplineMeshComponent*> SplineMeshes;
 
-	if (UWorld* const World = SplineComp->GetWorld())
+	if (SplineComp->GetWorld())
 	{
-		// Base the up vector for each spline point
-		for (int32 index = 0; index < (SplineComp->GetNumberOfSplinePoints() - 1); index++)
+		TArray<FExtraSplineMeshTile> Tiles;
+		FExtraSplineMeshBuilder::ComputeTiles(SplineComp, ConstructionInfo, Tiles);
+		const TArray<UMaterialInterface*> SplineMaterials = FExtraSplineMeshBuilder::GetTileMaterials(ConstructionInfo);
+
+		// Construct the spline meshes
+		SplineMeshes.Reserve(Tiles.Num());
+		for (const FExtraSplineMeshTile& Tile : Tiles)
 		{
-			if (!IsValidSplinePoint(SplineComp, index))
+			if (USplineMeshComponent* const MeshComp = FExtraSplineMeshBuilder::CreateTileComponent(SplineComp, ConstructionInfo, SplineMaterials, Tile))
 			{
-				break;
-			}			
-			SplineComp->SetUpVectorAtSplinePoint(index, 
-				FRotationMatrix(
-					SplineComp->GetRotationAtSplinePoint(index, ESplineCoordinateSpace::World)).GetScaledAxis(EAxis::Z), 
-				ESplineCoordinateSpace::World);
+				SplineMeshes.Add(MeshComp);
+			}
 		}
+		FExtraSplineMeshBuilder::CreateCollisionBodies(SplineComp, ConstructionInfo, Tiles);
+		FExtraSplineMeshBuilder::DrawTilesDebug(SplineComp, ConstructionInfo, Tiles);
+	}
+	
+	return SplineMeshes;
+}
 
-		const int32 SplineEndAmount = (FMath::TruncToInt(SplineComp->GetSplineLength() / ConstructionInfo.SplineTileLength) + 1);
+void UExtraFunctionalityLibrary::DestroySplineCollisionBodies(USplineComponent* SplineComp)
+{
+	if (!SplineComp)
+	{
+		return;
+	}
 
-		// Construct the spline meshes
-		for (int32 index = 0; index < SplineEndAmount; index++)
-		{			
-			// Setup the values to set for the spline meshes
-			const float CurrentDistance = index * ConstructionInfo.SplineTileLength;
-			const float NextDistance = FMath::Clamp((index + 1) * ConstructionInfo.SplineTileLength, 0.0f, SplineComp->GetSplineLength());
-			const float MidPointSplineDistance = (CurrentDistance + NextDistance) * 0.5f;
-			const float CurrentTileLength = NextDistance - CurrentDistance;
-
-			// Create component and set default values for it
-			USplineMeshComponent* MeshComp = NewObject<USplineMeshComponent>(SplineComp);
-			MeshComp->SetMobility(ConstructionInfo.Mobility);
-			if (MeshComp->GetAttachParent() != SplineComp)
-			{				
-				MeshComp->SetupAttachment(SplineComp);
+	// Copy since destroying detaches them from the spline
+	const TArray<USceneComponent*> Children = SplineComp->GetAttachChildren();
+	for (int32 index = Children.Num(); index-- > 0;)
+	{
+		if (Children[index] && Children[index]->ComponentHasTag(FExtraSplineMeshBuilder::CollisionBodyTag))
+		{
+			Children[index]->DestroyComponent();
+		}
+	}
+}
+
+UHierarchicalInstancedStaticMeshComponent* UExtraFunctionalityLibrary::ScatterInstancesAlongSpline(USplineComponent* SplineComp,
+	FExtraSplineScatterInfo ScatterInfo, UHierarchicalInstancedStaticMeshComponent* ExistingComponent)
+{
+	EXTRA_LLM_SCOPE(SplineMeshes);
+	UWorld* const World = SplineComp ? SplineComp->GetWorld() : nullptr;
+	if (!World || !ScatterInfo.Mesh)
+	{
+		return ExistingComponent;
+	}
+
+	// Evaluate every instance's spot on the spline in one go
+	const float SplineLength = SplineComp->GetSplineLength();
+	const float Spacing = FMath::Max(ScatterInfo.Spacing, 1.0f);
+	const int32 NumInstances = (SplineLength >= ScatterInfo.StartOffset) ? (FMath::FloorToInt((SplineLength - ScatterInfo.StartOffset) / Spacing) + 1) : 0;
+
+	TArray<float> Distances;
+	Distances.SetNumUninitialized(NumInstances);
+	for (int32 index = 0; index < NumInstances; index++)
+	{
+		Distances[index] = ScatterInfo.StartOffset + (index * Spacing);
+	}
+
+	FExtraSplineTransforms SplineTransforms;
+	EvaluateSplineTransforms(SplineComp, Distances, true, ESplineCoordinateSpace::Local, SplineTransforms);
+
+	// Instances live in the spline's local space, the component is attached with no offset
+	const FTransform& ComponentTransform = SplineComp->GetComponentTransform();
+	const ECollisionChannel GroundChannel = UEngineTypes::ConvertToCollisionChannel(ScatterInfo.GroundChannel);
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(ScatterInstancesAlongSpline), ScatterInfo.bTraceComplex);
+	Params.AddIgnoredActor(SplineComp->GetOwner());
+	FHitResult Hit;
+
+	TArray<FTransform> InstanceTransforms;
+	InstanceTransforms.SetNum(NumInstances);
+	for (int32 index = 0; index < NumInstances; index++)
+	{
+		FRandomStream Stream(HashCombine(GetTypeHash(ScatterInfo.RandomSeed), GetTypeHash(index)));
+
+		const FQuat SplineRotation = SplineTransforms.Rotations[index].Quaternion();
+		const FVector LocationJitter(
+			Stream.FRandRange(-ScatterInfo.LocationJitter.X, ScatterInfo.LocationJitter.X),
+			Stream.FRandRange(-ScatterInfo.LocationJitter.Y, ScatterInfo.LocationJitter.Y),
+			Stream.FRandRange(-ScatterInfo.LocationJitter.Z, ScatterInfo.LocationJitter.Z));
+		const FRotator RotationJitter(
+			Stream.FRandRange(-ScatterInfo.RotationJitter.Pitch, ScatterInfo.RotationJitter.Pitch),
+			Stream.FRandRange(-ScatterInfo.RotationJitter.Yaw, ScatterInfo.RotationJitter.Yaw),
+			Stream.FRandRange(-ScatterInfo.RotationJitter.Roll, ScatterInfo.RotationJitter.Roll));
+		const float Scale = Stream.FRandRange(ScatterInfo.MinScale, ScatterInfo.MaxScale);
+
+		FVector Location = SplineTransforms.Locations[index] + SplineRotation.RotateVector(LocationJitter);
+		const FQuat Rotation = (ScatterInfo.bAlignToSpline ? SplineRotation : FQuat::Identity) * RotationJitter.Quaternion();
+
+		if (ScatterInfo.bSnapToGround)
+		{
+			const FVector StartLoc = ComponentTransform.TransformPosition(Location);
+			FVector GroundLoc;
+			if (ScatterInfo.bUseGroundHeightCache && 
+				ExtraGroundSnap::FindCachedGround(World, StartLoc, ScatterInfo.GroundTraceDistance, ScatterInfo.GroundChannel, ScatterInfo.bTraceComplex, GroundLoc))
+			{
+				Location = ComponentTransform.InverseTransformPosition(GroundLoc);
 			}
-			MeshComp->SetRelativeTransform(FTransform());
-			MeshComp->SetStartScale(ConstructionInfo.StartScale, false);
-			MeshComp->SetEndScale(ConstructionInfo.EndScale, false);
-			MeshComp->SetCanEverAffectNavigation(ConstructionInfo.bAffectNavigation);
-			MeshComp->SetGenerateOverlapEvents(ConstructionInfo.bGenerateOverlapEvents);
-			MeshComp->SetCollisionObjectType(UEngineTypes::ConvertToCollisionChannel(ConstructionInfo.ObjectType));
-			MeshComp->SetCollisionEnabled(ConstructionInfo.CollisionEnabled);
-			MeshComp->SetForwardAxis(ConstructionInfo.ForwardAxis, false);
-			MeshComp->SetStaticMesh(ConstructionInfo.SplineMesh);
-			
-			// Apply the materials
+			else if (World->LineTraceSingleByChannel(Hit, StartLoc, StartLoc + (FVector(0.0f, 0.0f, -1.0f) * ScatterInfo.GroundTraceDistance), GroundChannel, Params))
 			{
-				TArray<UMaterialInterface*> SplineMaterials = (ConstructionInfo.OptionalMaterials.Num() > 0) ?
-					ConstructionInfo.OptionalMaterials : GetStaticMaterials(ConstructionInfo.SplineMesh);
-			
-				if (SplineMaterials.Num() > 0)
-				{
-					for (int MatIndex = SplineMaterials.Num(); MatIndex-- > 0;)
-					{
-						// Valid check
-						if (SplineMaterials[MatIndex])
-						{
-							MeshComp->SetMaterial(MatIndex, SplineMaterials[MatIndex]);
-						}
-					}
-				}
+				Location = ComponentTransform.InverseTransformPosition(Hit.ImpactPoint);
 			}
-			MeshComp->SetSplineUpDir(
-				FRotationMatrix(
-					SplineComp->GetRotationAtDistanceAlongSpline(MidPointSplineDistance, ESplineCoordinateSpace::Local)).GetScaledAxis(EAxis::Z), 
-				false);
+		}
 
-			// Set start & end
-			{
-				const FVector SplineStartTangent = SplineComp->GetTangentAtDistanceAlongSpline(CurrentDistance, ESplineCoordinateSpace::Local);
-				const FVector StartTangent = SplineStartTangent.GetSafeNormal() * FMath::Min(SplineStartTangent.Size(), CurrentTileLength);
+		InstanceTransforms[index] = FTransform(Rotation, Location, FVector(Scale));
+	}
 
-				const FVector SplineEndTangent = SplineComp->GetTangentAtDistanceAlongSpline(NextDistance, ESplineCoordinateSpace::Local);
-				const FVector EndTangent = SplineEndTangent.GetSafeNormal() * FMath::Min(SplineEndTangent.Size(), CurrentTileLength);
+	// Create the component the first time
+	UHierarchicalInstancedStaticMeshComponent* Instances = ExistingComponent;
+	const bool bNewComponent = (!Instances || Instances->IsPendingKill());
+	if (bNewComponent)
+	{
+		Instances = NewObject<UHierarchicalInstancedStaticMeshComponent>(SplineComp);
+		Instances->SetupAttachment(SplineComp);
+		Instances->SetRelativeTransform(FTransform());
+	}
 
-				MeshComp->SetStartAndEnd(SplineComp->GetLocationAtDistanceAlongSpline(CurrentDistance, ESplineCoordinateSpace::Local), StartTangent,
-					SplineComp->GetLocationAtDistanceAlongSpline(NextDistance, ESplineCoordinateSpace::Local), EndTangent, false);
-			}
-			
-			// Set starting roll
+	if (Instances->GetStaticMesh() != ScatterInfo.Mesh)
+	{
+		// Old instances were sized for a different mesh, start over
+		Instances->ClearInstances();
+		Instances->SetStaticMesh(ScatterInfo.Mesh);
+	}
+	for (int32 MatIndex = ScatterInfo.OptionalMaterials.Num(); MatIndex-- > 0;)
+	{
+		if (ScatterInfo.OptionalMaterials[MatIndex])
+		{
+			Instances->SetMaterial(MatIndex, ScatterInfo.OptionalMaterials[MatIndex]);
+		}
+	}
+	Instances->SetCollisionObjectType(UEngineTypes::ConvertToCollisionChannel(ScatterInfo.ObjectType));
+	Instances->SetCollisionEnabled(ScatterInfo.CollisionEnabled);
+	Instances->SetCullDistances(0, FMath::TruncToInt(ScatterInfo.CullDistance));
+	Instances->SetCastShadow(ScatterInfo.bCastShadow);
+
+	// Only touch the instances that actually moved, a spline edit usually only moves the ones near the edited points
+	const int32 NumExisting = Instances->GetInstanceCount();
+	const int32 NumShared = FMath::Min(NumExisting, NumInstances);
+	int32 FirstChanged = INDEX_NONE;
+	int32 LastChanged = INDEX_NONE;
+	FTransform ExistingTransform;
+	for (int32 index = 0; index < NumShared; index++)
+	{
+		Instances->GetInstanceTransform(index, ExistingTransform, false);
+		if (!ExistingTransform.Equals(InstanceTransforms[index], KINDA_SMALL_NUMBER))
+		{
+			FirstChanged = (FirstChanged == INDEX_NONE) ? index : FirstChanged;
+			LastChanged = index;
+		}
+	}
+	if (FirstChanged != INDEX_NONE)
+	{
+		const TArray<FTransform> ChangedTransforms(InstanceTransforms.GetData() + FirstChanged, (LastChanged - FirstChanged) + 1);
+		Instances->BatchUpdateInstancesTransforms(FirstChanged, ChangedTransforms, false, false, true);
+	}
+
+	for (int32 index = NumExisting; index-- > NumInstances;)
+	{
+		Instances->RemoveInstance(index);
+	}
+	for (int32 index = NumShared; index < NumInstances; index++)
+	{
+		Instances->AddInstance(InstanceTransforms[index]);
+	}
+
+	if (bNewComponent)
+	{
+		Instances->RegisterComponentWithWorld(World);
+	}
+	else if (FirstChanged != INDEX_NONE || NumExisting != NumInstances)
+	{
+		Instances->MarkRenderStateDirty();
+	}
+	return Instances;
+}
+
+namespace ExtraSplineSimplify
+{
+	/** Samples per original segment used to measure how far a simplified segment strays */
+	static const int32 SamplesPerSegment = 8;
+
+	/**
+	* Measures the single segment that would replace the original points from First to Last(Last can be the number of points on a loop, meaning point 0).
+	* Samples are compared at matching keys, which is a little stricter than comparing against the closest point.
+	* OutWorstPoint is the original point in between that's nearest the sample that's the furthest over the tolerances.
+	*/
+	static void MeasureSpan(const FSplineCurves& Curves, int32 First, int32 Last, float PositionTolerance, float AngleTolerance, float ScaleTolerance,
+		float& OutPositionError, float& OutAngleError, float& OutScaleError, int32& OutWorstPoint)
+	{
+		const int32 NumPoints = Curves.Position.Points.Num();
+		const FInterpCurvePoint<FVector>& Start = Curves.Position.Points[First];
+		const FInterpCurvePoint<FVector>& End = Curves.Position.Points[Last % NumPoints];
+		const FQuat StartRotation = Curves.Rotation.Points[First].OutVal;
+		const FQuat EndRotation = Curves.Rotation.Points[Last % NumPoints].OutVal;
+		const FVector StartScale = Curves.Scale.Points[First].OutVal;
+		const FVector EndScale = Curves.Scale.Points[Last % NumPoints].OutVal;
+		const bool bLinear = (Start.InterpMode == CIM_Linear);
+		const float Span = Last - First;
+		const FVector StartTangent = Start.LeaveTangent * Span;
+		const FVector EndTangent = End.ArriveTangent * Span;
+
+		OutPositionError = 0.0f;
+		OutAngleError = 0.0f;
+		OutScaleError = 0.0f;
+		OutWorstPoint = First + 1;
+		float WorstScore = -1.0f;
+
+		const int32 NumSamples = (Last - First) * SamplesPerSegment;
+		for (int32 index = 1; index < NumSamples; index++)
+		{
+			const float Alpha = (float)index / NumSamples;
+			const float InKey = First + (Alpha * Span);
+
+			const FVector Location = bLinear ? FMath::Lerp(Start.OutVal, End.OutVal, Alpha) : FMath::CubicInterp(Start.OutVal, StartTangent, End.OutVal, EndTangent, Alpha);
+			const FVector Direction = bLinear ? (End.OutVal - Start.OutVal) : FMath::CubicInterpDerivative(Start.OutVal, StartTangent, End.OutVal, EndTangent, Alpha);
+			const float PositionError = FVector::Dist(Location, Curves.Position.Eval(InKey, FVector::ZeroVector));
+
+			float AngleError = 0.0f;
+			if (AngleTolerance > 0.0f)
 			{
-				const float CorrectedRoll = UExtraFunctionalityLibrary::SetSplineMeshRelativeRoll(SplineComp,
-					SplineComp->GetRotationAtDistanceAlongSpline(MidPointSplineDistance, ESplineCoordinateSpace::Local), CurrentDistance, true);
-				MeshComp->SetStartRoll(CorrectedRoll, false);
+				const float DirectionDot = Direction.GetSafeNormal() | Curves.Position.EvalDerivative(InKey, FVector::ZeroVector).GetSafeNormal();
+				const FQuat Rotation = FQuat::Slerp(StartRotation, EndRotation, Alpha);
+				const FQuat OriginalRotation = Curves.Rotation.Eval(InKey, FQuat::Identity).GetNormalized();
+				AngleError = FMath::Max(FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(DirectionDot, -1.0f, 1.0f))),
+					FMath::RadiansToDegrees(Rotation.AngularDistance(OriginalRotation)));
 			}
 
-			// Set end roll
+			// Like rotation, the scale of the kept points is blended across the new segment
+			float ScaleError = 0.0f;
+			if (ScaleTolerance > 0.0f)
 			{
-				const float CorrectedRoll = UExtraFunctionalityLibrary::SetSplineMeshRelativeRoll(SplineComp,
-					SplineComp->GetRotationAtDistanceAlongSpline(MidPointSplineDistance, ESplineCoordinateSpace::Local), NextDistance, true);
-				MeshComp->SetEndRoll(CorrectedRoll, false);
+				const FVector Scale = FMath::Lerp(StartScale, EndScale, Alpha);
+				ScaleError = (Scale - Curves.Scale.Eval(InKey, FVector::OneVector)).GetAbsMax();
 			}
 
-			MeshComp->UpdateMesh();
-			MeshComp->RegisterComponentWithWorld(World);
-			SplineMeshes.Add(MeshComp);
+			OutPositionError = FMath::Max(OutPositionError, PositionError);
+			OutAngleError = FMath::Max(OutAngleError, AngleError);
+			OutScaleError = FMath::Max(OutScaleError, ScaleError);
 
-			if (ConstructionInfo.bDebugMode)
-			{				
-				const FVector StartLoc = (SplineComp->GetLocationAtDistanceAlongSpline(MidPointSplineDistance, ESplineCoordinateSpace::World));
-				const FRotator BaseRotation = (SplineComp->GetRotationAtDistanceAlongSpline(MidPointSplineDistance, ESplineCoordinateSpace::World));
-				const float Length = ConstructionInfo.ArrowLength;
-				const float Size = ConstructionInfo.ArrowSize;
-				const float Thickness = ConstructionInfo.ArrowThickness;
-				const float DisplayTime = ConstructionInfo.DebugTime;
-
-				// X
-				DrawDebugDirectionalArrow(World, StartLoc, StartLoc + (FRotationMatrix(BaseRotation).GetScaledAxis(EAxis::X) * Length),
-					Size, FColor::Red, false, DisplayTime, SDPG_World, Thickness);
-				// Y
-				DrawDebugDirectionalArrow(World, StartLoc, StartLoc + (FRotationMatrix(BaseRotation).GetScaledAxis(EAxis::Y) * Length),
-					Size, FColor::Green, false, DisplayTime, SDPG_World, Thickness);
-				// Z
-				DrawDebugDirectionalArrow(World, StartLoc, StartLoc + (FRotationMatrix(BaseRotation).GetScaledAxis(EAxis::Z) * Length),
-					Size, FColor::Blue, false, DisplayTime, SDPG_World, Thickness);
+			const float Score = FMath::Max3(PositionError / PositionTolerance, (AngleTolerance > 0.0f) ? (AngleError / AngleTolerance) : 0.0f,
+				(ScaleTolerance > 0.0f) ? (ScaleError / ScaleTolerance) : 0.0f);
+			if (Score > WorstScore)
+			{
+				WorstScore = Score;
+				OutWorstPoint = FMath::Clamp(FMath::RoundToInt(InKey), First + 1, Last - 1);
 			}
 		}
 	}
-	
-	return SplineMeshes;
+}
+
+FExtraSplineSimplifyResult UExtraFunctionalityLibrary::SimplifySpline(USplineComponent* SplineComp, float PositionTolerance, float AngleTolerance, float ScaleTolerance)
+{
+	EXTRA_LLM_SCOPE(Splines);
+	FExtraSplineSimplifyResult Result;
+	if (!SplineComp)
+	{
+		return Result;
+	}
+
+	const FSplineCurves& Curves = SplineComp->SplineCurves;
+	const int32 NumPoints = Curves.Position.Points.Num();
+	Result.OriginalNumPoints = NumPoints;
+	Result.NumPoints = NumPoints;
+	if (NumPoints < 3)
+	{
+		return Result;
+	}
+
+	PositionTolerance = FMath::Max(PositionTolerance, KINDA_SMALL_NUMBER);
+
+	// On a loop the last index is point 0 again, so the closing segment can be simplified too
+	const bool bClosedLoop = SplineComp->IsClosedLoop();
+	const int32 LastIndex = bClosedLoop ? NumPoints : (NumPoints - 1);
+
+	TArray<bool> KeepPoint;
+	KeepPoint.Init(false, LastIndex + 1);
+	KeepPoint[0] = true;
+	KeepPoint[LastIndex] = true;
+	for (int32 index = 1; index < LastIndex; index++)
+	{
+		// Constant points are steps, there is no curve to approximate them with. The point after one is kept too,
+		// otherwise the step would swallow the curved segments that follow it
+		KeepPoint[index] = (Curves.Position.Points[index].InterpMode == CIM_Constant) || (Curves.Position.Points[index - 1].InterpMode == CIM_Constant);
+	}
+
+	TArray<TPair<int32, int32>> Spans;
+	for (int32 First = 0, index = 1; index <= LastIndex; index++)
+	{
+		if (KeepPoint[index])
+		{
+			Spans.Emplace(First, index);
+			First = index;
+		}
+	}
+
+	while (Spans.Num() > 0)
+	{
+		const TPair<int32, int32> Span = Spans.Pop(false);
+		if ((Span.Value - Span.Key) < 2)
+		{
+			continue;
+		}
+
+		float PositionError;
+		float AngleError;
+		float ScaleError;
+		int32 WorstPoint;
+		ExtraSplineSimplify::MeasureSpan(Curves, Span.Key, Span.Value, PositionTolerance, AngleTolerance, ScaleTolerance, 
+			PositionError, AngleError, ScaleError, WorstPoint);
+		if (PositionError <= PositionTolerance && (AngleTolerance <= 0.0f || AngleError <= AngleTolerance) && (ScaleTolerance <= 0.0f || ScaleError <= ScaleTolerance))
+		{
+			Result.MaxPositionDeviation = FMath::Max(Result.MaxPositionDeviation, PositionError);
+			Result.MaxAngleDeviation = FMath::Max(Result.MaxAngleDeviation, AngleError);
+			Result.MaxScaleDeviation = FMath::Max(Result.MaxScaleDeviation, ScaleError);
+			continue;
+		}
+
+		// Too far off, keep the worst point and try both halves
+		KeepPoint[WorstPoint] = true;
+		Spans.Emplace(Span.Key, WorstPoint);
+		Spans.Emplace(WorstPoint, Span.Value);
+	}
+
+	TArray<int32> KeptPoints;
+	for (int32 index = 0; index < NumPoints; index++)
+	{
+		if (KeepPoint[index])
+		{
+			KeptPoints.Add(index);
+		}
+	}
+	if (KeptPoints.Num() == NumPoints)
+	{
+		return Result;
+	}
+
+	// Tangents are per input key, a segment that now covers several old segments needs its tangents scaled up by as many
+	TArray<FSplinePoint> NewPoints;
+	NewPoints.Reserve(KeptPoints.Num());
+	for (int32 index = 0; index < KeptPoints.Num(); index++)
+	{
+		const int32 PointIndex = KeptPoints[index];
+		const int32 PreviousPoint = (index > 0) ? KeptPoints[index - 1] : (bClosedLoop ? (KeptPoints.Last() - LastIndex) : (PointIndex - 1));
+		const int32 NextPoint = (index < KeptPoints.Num() - 1) ? KeptPoints[index + 1] : (bClosedLoop ? LastIndex : (PointIndex + 1));
+		const FInterpCurvePoint<FVector>& PositionPoint = Curves.Position.Points[PointIndex];
+
+		ESplinePointType::Type PointType = ESplinePointType::CurveCustomTangent;
+		if (PositionPoint.InterpMode == CIM_Linear)
+		{
+			PointType = ESplinePointType::Linear;
+		}
+		else if (PositionPoint.InterpMode == CIM_Constant)
+		{
+			PointType = ESplinePointType::Constant;
+		}
+
+		NewPoints.Emplace(index, PositionPoint.OutVal,
+			PositionPoint.ArriveTangent * (PointIndex - PreviousPoint),
+			PositionPoint.LeaveTangent * (NextPoint - PointIndex),
+			Curves.Rotation.Points[PointIndex].OutVal.Rotator(),
+			Curves.Scale.Points[PointIndex].OutVal,
+			PointType);
+	}
+
+	SplineComp->ClearSplinePoints(false);
+	SplineComp->AddPoints(NewPoints, true);
+	Result.NumPoints = NewPoints.Num();
+
+	UE_LOG(LogExtraFunctionalityLibrary, Verbose, TEXT("Simplified %s from %d to %d points, max deviation %f units, %f degrees and %f scale"),
+		*GetNameSafe(SplineComp), Result.OriginalNumPoints, Result.NumPoints, Result.MaxPositionDeviation, Result.MaxAngleDeviation, Result.MaxScaleDeviation);
+	return Result;
+}
+
+uint32 UExtraFunctionalityLibrary::GetSplineCurvesHash(const USplineComponent* SplineComp)
+{
+	if (!SplineComp)
+	{
+		return 0;
+	}
+
+	// Hash the fields one by one instead of the raw point memory so padding bytes don't change the result
+	const FSplineCurves& Curves = SplineComp->SplineCurves;
+	uint32 Hash = GetTypeHash(Curves.Position.Points.Num());
+	for (const FInterpCurvePoint<FVector>& Point : Curves.Position.Points)
+	{
+		Hash = HashCombine(Hash, GetTypeHash(Point.InVal));
+		Hash = HashCombine(Hash, FCrc::MemCrc32(&Point.OutVal, sizeof(FVector)));
+		Hash = HashCombine(Hash, FCrc::MemCrc32(&Point.ArriveTangent, sizeof(FVector)));
+		Hash = HashCombine(Hash, FCrc::MemCrc32(&Point.LeaveTangent, sizeof(FVector)));
+		Hash = HashCombine(Hash, GetTypeHash((uint8)Point.InterpMode));
+	}
+	for (const FInterpCurvePoint<FQuat>& Point : Curves.Rotation.Points)
+	{
+		Hash = HashCombine(Hash, FCrc::MemCrc32(&Point.OutVal, sizeof(FQuat)));
+		Hash = HashCombine(Hash, GetTypeHash((uint8)Point.InterpMode));
+	}
+	for (const FInterpCurvePoint<FVector>& Point : Curves.Scale.Points)
+	{
+		Hash = HashCombine(Hash, FCrc::MemCrc32(&Point.OutVal, sizeof(FVector)));
+		Hash = HashCombine(Hash, GetTypeHash((uint8)Point.InterpMode));
+	}
+	Hash = HashCombine(Hash, GetTypeHash(SplineComp->IsClosedLoop()));
+	Hash = HashCombine(Hash, FCrc::MemCrc32(&SplineComp->DefaultUpVector, sizeof(FVector)));
+	return Hash;
 }
 
 void UExtraFunctionalityLibrary::StartRecordingReplay(const UObject* WorldContextObject, const FString & ReplayName,
 	const FString & FriendlyName)
 {
+	EXTRA_LLM_SCOPE(Replays);
 	if (const UWorld* const World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
 	{						
 		if(UGameInstance* const Gi = World->GetGameInstance())
 		{
 			UE_LOG(LogExtraFunctionalityLibrary, Display, TEXT("Started recording replay, ReplayName : [%s], FriendlyName : [%s]"), *ReplayName, *FriendlyName);
 			Gi->StartRecordingReplay(ReplayName, FriendlyName);
+
+			if (UExtraReplayCatalogSubsystem* const Catalog = Gi->GetSubsystem<UExtraReplayCatalogSubsystem>())
+			{
+				Catalog->NotifyRecordingStarted(ReplayName);
+			}
 		}
 		else
 		{
@@ -1677,6 +2718,11 @@ void UExtraFunctionalityLibrary::StopRecordingReplay(const UObject* WorldContext
 		{
 			UE_LOG(LogExtraFunctionalityLibrary, Display, TEXT("Generically stopping recording of replay"));
 			Gi->StopRecordingReplay();
+
+			if (UExtraReplayCatalogSubsystem* const Catalog = Gi->GetSubsystem<UExtraReplayCatalogSubsystem>())
+			{
+				Catalog->NotifyRecordingStopped();
+			}
 		}
 		else
 		{
@@ -1719,6 +2765,7 @@ void UExtraFunctionalityLibrary::SaveReplayCheckpoint(const UObject * WorldConte
 
 bool UExtraFunctionalityLibrary::PlayReplay(const UObject* WorldContextObject, const FString & ReplayName)
 {
+	EXTRA_LLM_SCOPE(Replays);
 	if (const UWorld* const World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
 	{
 		if (UGameInstance* const Gi = World->GetGameInstance())
@@ -1738,6 +2785,11 @@ void UExtraFunctionalityLibrary::AddUserToReplay(const UObject* WorldContextObje
 		{
 			UE_LOG(LogExtraFunctionalityLibrary, Display, TEXT("Added [%s] to replay"), *UserString);
 			Gi->AddUserToReplay(UserString);
+
+			if (UExtraReplayCatalogSubsystem* const Catalog = Gi->GetSubsystem<UExtraReplayCatalogSubsystem>())
+			{
+				Catalog->NotifyUserAdded(UserString);
+			}
 		}
 	}
 }
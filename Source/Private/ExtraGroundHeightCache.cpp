@@ -0,0 +1,410 @@
+#include "ExtraGroundHeightCache.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "Engine/LevelBounds.h"
+#include "ExtraMemoryTracking.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY(LogExtraGroundHeightCache);
+
+namespace ExtraGroundHeight
+{
+	static const float NoGroundHeight = -MAX_flt;
+	/** Room left above and below the level bounds so surfaces right on the bounds are still hit */
+	static const float TraceBoundsPadding = 100.0f;
+
+	/** Only static colliding components are ever sampled, so only those can make a tile stale */
+	static bool AffectsGroundHeight(const UPrimitiveComponent* Component)
+	{
+		return Component && Component->Mobility == EComponentMobility::Static && Component->IsCollisionEnabled();
+	}
+
+	static FAutoConsoleCommandWithWorld InvalidateCommand(
+		TEXT("ExtraFunctionality.GroundCache.Invalidate"),
+		TEXT("Throws away every cached ground height tile in the current world."),
+		FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* InWorld)
+		{
+			if (UExtraGroundHeightCacheSubsystem* const Cache = UExtraGroundHeightCacheSubsystem::Get(InWorld))
+			{
+				Cache->InvalidateAll();
+			}
+		}));
+}
+
+UExtraGroundHeightCacheSubsystem::UExtraGroundHeightCacheSubsystem()
+{
+	MaxCachedTiles = 256;
+	MaxInterpolatedHeightDifference = 50.0f;
+
+	CellSize = 100.0f;
+	CellsPerTile = 32;
+	MinHeight = -100000.0f;
+	MaxHeight = 100000.0f;
+
+	LastTileId = 0;
+	GeometryBounds.Init();
+	bGeometryBoundsDirty = true;
+}
+
+void UExtraGroundHeightCacheSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UExtraGroundHeightCacheSubsystem::OnLevelChanged);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &UExtraGroundHeightCacheSubsystem::OnLevelChanged);
+	if (UWorld* const World = GetWorld())
+	{
+		ActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UExtraGroundHeightCacheSubsystem::OnActorSpawned));
+	}
+#if WITH_EDITOR
+	if (GEngine)
+	{
+		ActorMovedHandle = GEngine->OnActorMoved().AddUObject(this, &UExtraGroundHeightCacheSubsystem::OnActorMoved);
+	}
+	ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddUObject(this, &UExtraGroundHeightCacheSubsystem::OnObjectModified);
+#endif
+}
+
+void UExtraGroundHeightCacheSubsystem::Deinitialize()
+{
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	if (UWorld* const World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+#if WITH_EDITOR
+	if (GEngine)
+	{
+		GEngine->OnActorMoved().Remove(ActorMovedHandle);
+	}
+	FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+#endif
+	Tiles.Empty();
+
+	Super::Deinitialize();
+}
+
+UExtraGroundHeightCacheSubsystem* UExtraGroundHeightCacheSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (const UWorld* const World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull))
+	{
+		return World->GetSubsystem<UExtraGroundHeightCacheSubsystem>();
+	}
+	return nullptr;
+}
+
+bool UExtraGroundHeightCacheSubsystem::GetGroundHeight(const FVector& Location, ETraceTypeQuery TraceChannel, bool bTraceComplex, float& OutHeight)
+{
+	OutHeight = 0.0f;
+
+	// Location in cells, the integer part is the sample to the lower left and the fraction is the bilinear alpha
+	const float CellX = Location.X / CellSize;
+	const float CellY = Location.Y / CellSize;
+	const int32 SampleX = FMath::FloorToInt(CellX);
+	const int32 SampleY = FMath::FloorToInt(CellY);
+
+	const FIntPoint TileCoord(
+		FMath::FloorToInt(SampleX / (float)CellsPerTile),
+		FMath::FloorToInt(SampleY / (float)CellsPerTile));
+	const FTile& Tile = FindOrSampleTile(TileCoord, TraceChannel, bTraceComplex);
+	if (Tile.NumPendingTraces > 0)
+	{
+		return false;
+	}
+
+	// Tiles share their edge samples with their neighbours so all 4 samples are always in the same tile
+	const int32 LocalX = SampleX - (TileCoord.X * CellsPerTile);
+	const int32 LocalY = SampleY - (TileCoord.Y * CellsPerTile);
+	const int32 Stride = CellsPerTile + 1;
+
+	const float H00 = Tile.Heights[(LocalY * Stride) + LocalX];
+	const float H10 = Tile.Heights[(LocalY * Stride) + LocalX + 1];
+	const float H01 = Tile.Heights[((LocalY + 1) * Stride) + LocalX];
+	const float H11 = Tile.Heights[((LocalY + 1) * Stride) + LocalX + 1];
+
+	if (H00 == ExtraGroundHeight::NoGroundHeight || H10 == ExtraGroundHeight::NoGroundHeight ||
+		H01 == ExtraGroundHeight::NoGroundHeight || H11 == ExtraGroundHeight::NoGroundHeight)
+	{
+		return false;
+	}
+
+	if ((FMath::Max(FMath::Max(H00, H10), FMath::Max(H01, H11)) - FMath::Min(FMath::Min(H00, H10), FMath::Min(H01, H11))) > MaxInterpolatedHeightDifference)
+	{
+		return false;
+	}
+
+	const float AlphaX = CellX - SampleX;
+	const float AlphaY = CellY - SampleY;
+	OutHeight = FMath::BiLerp(H00, H10, H01, H11, AlphaX, AlphaY);
+	return true;
+}
+
+void UExtraGroundHeightCacheSubsystem::Configure(float InCellSize, int32 InCellsPerTile, float InMinHeight, float InMaxHeight)
+{
+	CellSize = FMath::Max(InCellSize, 1.0f);
+	CellsPerTile = FMath::Clamp(InCellsPerTile, 1, 256);
+	MinHeight = FMath::Min(InMinHeight, InMaxHeight);
+	MaxHeight = FMath::Max(InMinHeight, InMaxHeight);
+	InvalidateAll();
+}
+
+void UExtraGroundHeightCacheSubsystem::InvalidateAll()
+{
+	Tiles.Reset();
+}
+
+void UExtraGroundHeightCacheSubsystem::InvalidateBounds(const FBox& Bounds)
+{
+	if (!Bounds.IsValid)
+	{
+		return;
+	}
+
+	const float TileSize = CellSize * CellsPerTile;
+	// Samples on a tile's edge are shared so pad by a cell to also catch the neighbouring tile
+	const FIntPoint MinTile(FMath::FloorToInt((Bounds.Min.X - CellSize) / TileSize), FMath::FloorToInt((Bounds.Min.Y - CellSize) / TileSize));
+	const FIntPoint MaxTile(FMath::FloorToInt((Bounds.Max.X + CellSize) / TileSize), FMath::FloorToInt((Bounds.Max.Y + CellSize) / TileSize));
+
+	for (auto It = Tiles.CreateIterator(); It; ++It)
+	{
+		const FIntPoint TileCoord = GetTileCoordFromKey(It.Key());
+		if (TileCoord.X >= MinTile.X && TileCoord.X <= MaxTile.X && TileCoord.Y >= MinTile.Y && TileCoord.Y <= MaxTile.Y)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UExtraGroundHeightCacheSubsystem::InvalidateActor(AActor* Actor)
+{
+	if (!Actor || Tiles.Num() == 0)
+	{
+		return;
+	}
+
+	FBox Bounds(ForceInit);
+	TInlineComponentArray<UPrimitiveComponent*> Primitives(Actor);
+	for (const UPrimitiveComponent* const Primitive : Primitives)
+	{
+		if (ExtraGroundHeight::AffectsGroundHeight(Primitive))
+		{
+			Bounds += Primitive->Bounds.GetBox();
+		}
+	}
+	InvalidateBounds(Bounds);
+}
+
+void UExtraGroundHeightCacheSubsystem::InvalidateComponent(UPrimitiveComponent* Component)
+{
+	if (Tiles.Num() > 0 && ExtraGroundHeight::AffectsGroundHeight(Component))
+	{
+		InvalidateBounds(Component->Bounds.GetBox());
+	}
+}
+
+uint64 UExtraGroundHeightCacheSubsystem::MakeTileKey(const FIntPoint& TileCoord, ETraceTypeQuery TraceChannel, bool bTraceComplex)
+{
+	// 24 bits per axis is still over a billion units away with the smallest cells
+	const uint64 X = (uint64)(TileCoord.X & 0xFFFFFF);
+	const uint64 Y = (uint64)(TileCoord.Y & 0xFFFFFF);
+	const uint64 Settings = ((uint64)TraceChannel << 1) | (bTraceComplex ? 1 : 0);
+	return (Settings << 48) | (Y << 24) | X;
+}
+
+FIntPoint UExtraGroundHeightCacheSubsystem::GetTileCoordFromKey(uint64 Key)
+{
+	// Sign extend the 24 bit coordinates back out
+	const int32 X = ((int32)((Key & 0xFFFFFF) << 8)) >> 8;
+	const int32 Y = ((int32)(((Key >> 24) & 0xFFFFFF) << 8)) >> 8;
+	return FIntPoint(X, Y);
+}
+
+const UExtraGroundHeightCacheSubsystem::FTile& UExtraGroundHeightCacheSubsystem::FindOrSampleTile(const FIntPoint& TileCoord, ETraceTypeQuery TraceChannel, bool bTraceComplex)
+{
+	EXTRA_LLM_SCOPE(Caches);
+	const uint64 Key = MakeTileKey(TileCoord, TraceChannel, bTraceComplex);
+	if (FTile* const Found = Tiles.Find(Key))
+	{
+		Found->LastUsedFrame = GFrameCounter;
+		return *Found;
+	}
+
+	if (Tiles.Num() >= MaxCachedTiles)
+	{
+		EvictTiles();
+	}
+
+	FTile& NewTile = Tiles.Add(Key);
+	NewTile.LastUsedFrame = GFrameCounter;
+	SampleTile(NewTile, Key, TileCoord, TraceChannel, bTraceComplex);
+	return NewTile;
+}
+
+void UExtraGroundHeightCacheSubsystem::SampleTile(FTile& Tile, uint64 Key, const FIntPoint& TileCoord, ETraceTypeQuery TraceChannel, bool bTraceComplex)
+{
+	const int32 Stride = CellsPerTile + 1;
+	Tile.Heights.Init(ExtraGroundHeight::NoGroundHeight, Stride * Stride);
+	Tile.TileId = ++LastTileId;
+	Tile.NumPendingTraces = 0;
+
+	UWorld* const World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	float TraceTop;
+	float TraceBottom;
+	GetTraceHeights(TraceTop, TraceBottom);
+	if (TraceTop <= TraceBottom)
+	{
+		return;
+	}
+
+	// Only static geometry is sampled since anything movable could be somewhere else by the time the sample is used
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(ExtraGroundHeightCache), bTraceComplex);
+	Params.MobilityType = EQueryMobilityType::Static;
+	const ECollisionChannel CollisionChannel = UEngineTypes::ConvertToCollisionChannel(TraceChannel);
+
+	// The traces run alongside the frame instead of stalling the game thread, each one carries its sample index as user data
+	FTraceDelegate TraceDelegate = FTraceDelegate::CreateUObject(this, &UExtraGroundHeightCacheSubsystem::OnSampleTraceDone, Key, Tile.TileId);
+	const FIntPoint FirstSample = TileCoord * CellsPerTile;
+
+	for (int32 Y = 0; Y < Stride; Y++)
+	{
+		for (int32 X = 0; X < Stride; X++)
+		{
+			const float WorldX = (FirstSample.X + X) * CellSize;
+			const float WorldY = (FirstSample.Y + Y) * CellSize;
+			World->AsyncLineTraceByChannel(EAsyncTraceType::Single, FVector(WorldX, WorldY, TraceTop), FVector(WorldX, WorldY, TraceBottom),
+				CollisionChannel, Params, FCollisionResponseParams::DefaultResponseParam, &TraceDelegate, (uint32)((Y * Stride) + X));
+		}
+	}
+	Tile.NumPendingTraces = Stride * Stride;
+
+	UE_LOG(LogExtraGroundHeightCache, Verbose, TEXT("Sampling ground height tile [%d, %d] with %d async traces"), TileCoord.X, TileCoord.Y, Stride * Stride);
+}
+
+void UExtraGroundHeightCacheSubsystem::OnSampleTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum, uint64 Key, uint32 TileId)
+{
+	// The tile could have been evicted or invalidated since the trace was issued
+	FTile* const Tile = Tiles.Find(Key);
+	if (!Tile || Tile->TileId != TileId || !Tile->Heights.IsValidIndex((int32)Datum.UserData))
+	{
+		return;
+	}
+
+	if (Datum.OutHits.Num() > 0 && Datum.OutHits[0].bBlockingHit)
+	{
+		Tile->Heights[(int32)Datum.UserData] = Datum.OutHits[0].ImpactPoint.Z;
+	}
+	Tile->NumPendingTraces--;
+}
+
+void UExtraGroundHeightCacheSubsystem::GetTraceHeights(float& OutTop, float& OutBottom)
+{
+	if (bGeometryBoundsDirty)
+	{
+		bGeometryBoundsDirty = false;
+		GeometryBounds.Init();
+		if (const UWorld* const World = GetWorld())
+		{
+			for (ULevel* const Level : World->GetLevels())
+			{
+				if (Level && Level->bIsVisible)
+				{
+					GeometryBounds += ALevelBounds::CalculateLevelBounds(Level);
+				}
+			}
+		}
+	}
+
+	OutTop = MaxHeight;
+	OutBottom = MinHeight;
+	if (GeometryBounds.IsValid)
+	{
+		OutTop = FMath::Min(OutTop, GeometryBounds.Max.Z + ExtraGroundHeight::TraceBoundsPadding);
+		OutBottom = FMath::Max(OutBottom, GeometryBounds.Min.Z - ExtraGroundHeight::TraceBoundsPadding);
+	}
+}
+
+void UExtraGroundHeightCacheSubsystem::EvictTiles()
+{
+	// Throw away the oldest quarter at once so we aren't sorting on every new tile
+	TArray<TPair<uint64, uint64>> ByAge;
+	ByAge.Reserve(Tiles.Num());
+	for (const TPair<uint64, FTile>& Pair : Tiles)
+	{
+		ByAge.Emplace(Pair.Value.LastUsedFrame, Pair.Key);
+	}
+	ByAge.Sort([](const TPair<uint64, uint64>& A, const TPair<uint64, uint64>& B) { return A.Key < B.Key; });
+
+	const int32 NumToRemove = FMath::Max(1, Tiles.Num() / 4);
+	for (int32 index = 0; index < NumToRemove; index++)
+	{
+		Tiles.Remove(ByAge[index].Value);
+	}
+}
+
+void UExtraGroundHeightCacheSubsystem::OnLevelChanged(ULevel* InLevel, UWorld* InWorld)
+{
+	if (InWorld == GetWorld())
+	{
+		bGeometryBoundsDirty = true;
+		InvalidateAll();
+	}
+}
+
+void UExtraGroundHeightCacheSubsystem::OnActorSpawned(AActor* InActor)
+{
+	// Static actors spawned at runtime, like streamed in or procedural geometry, can cover ground that was already sampled
+	// and reach outside the range the samples are traced over
+	if (InActor && !bGeometryBoundsDirty)
+	{
+		TInlineComponentArray<UPrimitiveComponent*> Primitives(InActor);
+		for (const UPrimitiveComponent* const Primitive : Primitives)
+		{
+			if (ExtraGroundHeight::AffectsGroundHeight(Primitive))
+			{
+				GeometryBounds += Primitive->Bounds.GetBox();
+			}
+		}
+	}
+	InvalidateActor(InActor);
+}
+
+#if WITH_EDITOR
+void UExtraGroundHeightCacheSubsystem::OnActorMoved(AActor* InActor)
+{
+	if (!InActor || InActor->GetWorld() != GetWorld() || Tiles.Num() == 0)
+	{
+		return;
+	}
+
+	// Only static geometry is ever sampled, so only moving that can make a tile stale
+	TInlineComponentArray<UPrimitiveComponent*> Primitives(InActor);
+	for (const UPrimitiveComponent* const Primitive : Primitives)
+	{
+		if (ExtraGroundHeight::AffectsGroundHeight(Primitive))
+		{
+			// The actor could have moved from anywhere, so the old location is unknown and everything has to go
+			InvalidateAll();
+			return;
+		}
+	}
+}
+
+void UExtraGroundHeightCacheSubsystem::OnObjectModified(UObject* InObject)
+{
+	// Landscape sculpting and painting modify the landscape's collision components, which are static primitives like any other
+	UPrimitiveComponent* const Component = Cast<UPrimitiveComponent>(InObject);
+	if (Component && Component->GetWorld() == GetWorld())
+	{
+		InvalidateComponent(Component);
+	}
+}
+#endif
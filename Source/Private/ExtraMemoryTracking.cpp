@@ -0,0 +1,160 @@
+#include "ExtraMemoryTracking.h"
+#include "HAL/IConsoleManager.h"
+#include "Stats/Stats.h"
+
+DEFINE_LOG_CATEGORY(LogExtraMemoryTracking);
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+DECLARE_LLM_MEMORY_STAT(TEXT("ExtraFunctionality"), STAT_ExtraFunctionalityLLM, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("ExtraFunctionality"), STAT_ExtraFunctionalitySummaryLLM, STATGROUP_LLM);
+DECLARE_LLM_MEMORY_STAT(TEXT("ExtraFunctionality/SplineMeshes"), STAT_ExtraSplineMeshesLLM, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("ExtraFunctionality/Splines"), STAT_ExtraSplinesLLM, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("ExtraFunctionality/Widgets"), STAT_ExtraWidgetsLLM, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("ExtraFunctionality/Files"), STAT_ExtraFilesLLM, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("ExtraFunctionality/Replays"), STAT_ExtraReplaysLLM, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("ExtraFunctionality/Caches"), STAT_ExtraCachesLLM, STATGROUP_LLMFULL);
+#endif
+
+int64 FExtraMemoryTracking::PeakBytes[(int32)EExtraLLMTag::Count] = {};
+FDelegateHandle FExtraMemoryTracking::SampleTickerHandle;
+
+namespace ExtraMemoryTracking
+{
+	/** How often the tags are sampled for their peaks */
+	static const float SampleInterval = 1.0f;
+
+	static const TCHAR* const TagNames[(int32)EExtraLLMTag::Count] =
+	{
+		TEXT("ExtraFunctionality"),
+		TEXT("ExtraFunctionality/SplineMeshes"),
+		TEXT("ExtraFunctionality/Splines"),
+		TEXT("ExtraFunctionality/Widgets"),
+		TEXT("ExtraFunctionality/Files"),
+		TEXT("ExtraFunctionality/Replays"),
+		TEXT("ExtraFunctionality/Caches"),
+	};
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	static FORCEINLINE ELLMTag ToLLMTag(int32 TagIndex)
+	{
+		return (ELLMTag)(EXTRA_LLM_TAG_START + TagIndex);
+	}
+
+	static int64 GetTagAmount(int32 TagIndex)
+	{
+		return FLowLevelMemTracker::Get().GetTagAmountForTracker(ELLMTracker::Default, ToLLMTag(TagIndex));
+	}
+#endif
+
+	static FAutoConsoleCommand MemReportCommand(
+		TEXT("Extra.MemReport"),
+		TEXT("Prints the current and peak memory of each of the Extra Functionality plugin's memory tracker tags, needs -LLM."),
+		FConsoleCommandDelegate::CreateStatic(&FExtraMemoryTracking::LogTagUsage));
+}
+
+void FExtraMemoryTracking::RegisterTags()
+{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	static_assert(EXTRA_LLM_TAG_START >= (int32)ELLMTag::ProjectTagStart && (EXTRA_LLM_TAG_START + (int32)EExtraLLMTag::Count - 1) <= (int32)ELLMTag::ProjectTagEnd,
+		"EXTRA_LLM_TAG_START has to leave room for every EExtraLLMTag within the project tag range");
+
+	if (!IsTrackingMemory())
+	{
+		return;
+	}
+
+	const FName StatNames[(int32)EExtraLLMTag::Count] =
+	{
+		GET_STATFNAME(STAT_ExtraFunctionalityLLM),
+		GET_STATFNAME(STAT_ExtraSplineMeshesLLM),
+		GET_STATFNAME(STAT_ExtraSplinesLLM),
+		GET_STATFNAME(STAT_ExtraWidgetsLLM),
+		GET_STATFNAME(STAT_ExtraFilesLLM),
+		GET_STATFNAME(STAT_ExtraReplaysLLM),
+		GET_STATFNAME(STAT_ExtraCachesLLM),
+	};
+
+	// The feature tags share the plugin's summary stat, so the summary shows the plugin as a whole
+	const FName SummaryStatName = GET_STATFNAME(STAT_ExtraFunctionalitySummaryLLM);
+	FLowLevelMemTracker& Tracker = FLowLevelMemTracker::Get();
+	for (int32 index = 0; index < (int32)EExtraLLMTag::Count; index++)
+	{
+		Tracker.RegisterProjectTag(EXTRA_LLM_TAG_START + index, ExtraMemoryTracking::TagNames[index], StatNames[index], SummaryStatName);
+	}
+
+	SampleTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&FExtraMemoryTracking::SamplePeaks),
+		ExtraMemoryTracking::SampleInterval);
+#endif
+}
+
+void FExtraMemoryTracking::UnregisterTags()
+{
+	// The tracker has no way to remove tags, only the sampling stops
+	if (SampleTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(SampleTickerHandle);
+		SampleTickerHandle.Reset();
+	}
+}
+
+bool FExtraMemoryTracking::IsTrackingMemory()
+{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	return FLowLevelMemTracker::IsEnabled();
+#else
+	return false;
+#endif
+}
+
+TArray<FExtraMemoryTagUsage> FExtraMemoryTracking::GetTagUsage()
+{
+	TArray<FExtraMemoryTagUsage> Usage;
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	if (!IsTrackingMemory())
+	{
+		return Usage;
+	}
+
+	SamplePeaks(0.0f);
+	Usage.SetNum((int32)EExtraLLMTag::Count);
+	for (int32 index = 0; index < (int32)EExtraLLMTag::Count; index++)
+	{
+		Usage[index].TagName = ExtraMemoryTracking::TagNames[index];
+		Usage[index].CurrentBytes = ExtraMemoryTracking::GetTagAmount(index);
+		Usage[index].PeakBytes = PeakBytes[index];
+	}
+#endif
+	return Usage;
+}
+
+void FExtraMemoryTracking::LogTagUsage()
+{
+	if (!IsTrackingMemory())
+	{
+		UE_LOG(LogExtraMemoryTracking, Display, TEXT("Memory isn't being tracked, run with -LLM to track the plugin's memory."));
+		return;
+	}
+
+	for (const FExtraMemoryTagUsage& Tag : GetTagUsage())
+	{
+		UE_LOG(LogExtraMemoryTracking, Display, TEXT("%-36s %10.2f MB current %10.2f MB peak"), *Tag.TagName.ToString(),
+			Tag.CurrentBytes / (1024.0 * 1024.0), Tag.PeakBytes / (1024.0 * 1024.0));
+	}
+}
+
+const TCHAR* FExtraMemoryTracking::GetTagName(EExtraLLMTag Tag)
+{
+	return (Tag < EExtraLLMTag::Count) ? ExtraMemoryTracking::TagNames[(int32)Tag] : TEXT("");
+}
+
+bool FExtraMemoryTracking::SamplePeaks(float DeltaTime)
+{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	for (int32 index = 0; index < (int32)EExtraLLMTag::Count; index++)
+	{
+		PeakBytes[index] = FMath::Max(PeakBytes[index], ExtraMemoryTracking::GetTagAmount(index));
+	}
+#endif
+	// Keep ticking
+	return true;
+}
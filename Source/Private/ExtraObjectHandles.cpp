@@ -0,0 +1,151 @@
+#include "ExtraObjectHandles.h"
+#include "Engine/Engine.h"
+#include "ExtraMemoryTracking.h"
+
+DEFINE_LOG_CATEGORY(LogExtraObjectHandles);
+
+UExtraObjectHandleSubsystem::UExtraObjectHandleSubsystem()
+{
+	bListening = false;
+}
+
+void UExtraObjectHandleSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	GUObjectArray.AddUObjectDeleteListener(this);
+	bListening = true;
+}
+
+void UExtraObjectHandleSubsystem::Deinitialize()
+{
+	StopListening();
+	Slots.Empty();
+	FreeSlots.Empty();
+	ObjectToIndex.Empty();
+
+	Super::Deinitialize();
+}
+
+UExtraObjectHandleSubsystem* UExtraObjectHandleSubsystem::Get()
+{
+	return GEngine ? GEngine->GetEngineSubsystem<UExtraObjectHandleSubsystem>() : nullptr;
+}
+
+FExtraObjectHandle UExtraObjectHandleSubsystem::MakeHandle(UObject* Object)
+{
+	EXTRA_LLM_SCOPE(Caches);
+	if (!Object || Object->IsPendingKillOrUnreachable())
+	{
+		return FExtraObjectHandle();
+	}
+
+	if (const int32* const ExistingIndex = ObjectToIndex.Find(Object))
+	{
+		return FExtraObjectHandle(*ExistingIndex, Slots[*ExistingIndex].Generation);
+	}
+
+	int32 Index;
+	if (FreeSlots.Num() > 0)
+	{
+		Index = FreeSlots.Pop(false);
+	}
+	else
+	{
+		Index = Slots.AddUninitialized();
+		// 0 is reserved for unset handles
+		Slots[Index].Generation = 1;
+	}
+
+	Slots[Index].Object = Object;
+	ObjectToIndex.Add(Object, Index);
+	return FExtraObjectHandle(Index, Slots[Index].Generation);
+}
+
+UObject* UExtraObjectHandleSubsystem::ResolveHandle(const FExtraObjectHandle& Handle) const
+{
+	if (const FSlot* const Slot = FindSlot(Handle))
+	{
+		// Unreachable objects are about to be deleted by the running garbage collection, the engine treats them as gone already
+		UObject* const Object = (UObject*)Slot->Object;
+		return Object->IsPendingKillOrUnreachable() ? nullptr : Object;
+	}
+	return nullptr;
+}
+
+bool UExtraObjectHandleSubsystem::IsHandleValid(const FExtraObjectHandle& Handle) const
+{
+	return ResolveHandle(Handle) != nullptr;
+}
+
+int32 UExtraObjectHandleSubsystem::AreHandlesValid(const TArray<FExtraObjectHandle>& Handles, TArray<bool>& OutResults) const
+{
+	int32 NumValid = 0;
+	OutResults.SetNumUninitialized(Handles.Num());
+	for (int32 index = 0; index < Handles.Num(); index++)
+	{
+		OutResults[index] = IsHandleValid(Handles[index]);
+		NumValid += OutResults[index];
+	}
+	return NumValid;
+}
+
+bool UExtraObjectHandleSubsystem::AreAllHandlesValid(const TArray<FExtraObjectHandle>& Handles) const
+{
+	if (Handles.Num() == 0)
+	{
+		return false;
+	}
+
+	for (int32 index = Handles.Num(); index-- > 0;)
+	{
+		if (!IsHandleValid(Handles[index]))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+int32 UExtraObjectHandleSubsystem::CompactHandles(TArray<FExtraObjectHandle>& Handles) const
+{
+	int32 NumKept = 0;
+	for (int32 index = 0; index < Handles.Num(); index++)
+	{
+		if (IsHandleValid(Handles[index]))
+		{
+			Handles[NumKept++] = Handles[index];
+		}
+	}
+
+	const int32 NumRemoved = Handles.Num() - NumKept;
+	Handles.SetNum(NumKept, false);
+	return NumRemoved;
+}
+
+void UExtraObjectHandleSubsystem::NotifyUObjectDeleted(const UObjectBase* Object, int32 Index)
+{
+	int32 SlotIndex;
+	if (ObjectToIndex.RemoveAndCopyValue(Object, SlotIndex))
+	{
+		FSlot& Slot = Slots[SlotIndex];
+		Slot.Object = nullptr;
+		// Skip 0 when wrapping so a reused slot never looks unset
+		Slot.Generation = (Slot.Generation == MAX_int32) ? 1 : (Slot.Generation + 1);
+		FreeSlots.Add(SlotIndex);
+	}
+}
+
+void UExtraObjectHandleSubsystem::OnUObjectArrayShutdown()
+{
+	StopListening();
+}
+
+void UExtraObjectHandleSubsystem::StopListening()
+{
+	if (bListening)
+	{
+		GUObjectArray.RemoveUObjectDeleteListener(this);
+		bListening = false;
+	}
+}
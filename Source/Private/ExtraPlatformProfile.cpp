@@ -0,0 +1,175 @@
+#include "ExtraPlatformProfile.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+
+#if PLATFORM_CPU_X86_FAMILY
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+DEFINE_LOG_CATEGORY(LogExtraPlatformProfile);
+
+FExtraPlatformProfile FExtraPlatformProfiler::Profile;
+bool FExtraPlatformProfiler::bProfileBuilt = false;
+
+namespace ExtraPlatformProfile
+{
+	/** Tasks per worker a ParallelFor is split into, so uneven batches still balance out */
+	static const int32 BatchesPerWorker = 4;
+	/** Iterations of the benchmark loop per round */
+	static const int32 BenchmarkIterations = 1 << 18;
+	static const int32 BenchmarkRounds = 3;
+	/** Best round time of the benchmark that scores 100 */
+	static const double BenchmarkReferenceSeconds = 0.0015;
+
+	static void ReadCPUFeatures(FExtraPlatformProfile& OutProfile)
+	{
+#if PLATFORM_CPU_X86_FAMILY
+		uint32 Registers[4] = { 0, 0, 0, 0 };
+#if defined(_MSC_VER)
+		__cpuid((int32*)Registers, 0);
+#else
+		__cpuid(0, Registers[0], Registers[1], Registers[2], Registers[3]);
+#endif
+		const uint32 MaxLeaf = Registers[0];
+
+#if defined(_MSC_VER)
+		__cpuid((int32*)Registers, 1);
+#else
+		__cpuid(1, Registers[0], Registers[1], Registers[2], Registers[3]);
+#endif
+		OutProfile.bHasSSE42 = (Registers[2] & (1 << 20)) != 0;
+
+		// AVX also needs the OS to save the wider registers on context switches
+		const bool bOSXSave = (Registers[2] & (1 << 27)) != 0;
+		bool bOSSavesAVX = false;
+		if (bOSXSave)
+		{
+#if defined(_MSC_VER)
+			const uint64 XCR0 = _xgetbv(0);
+#else
+			uint32 XCR0Low, XCR0High;
+			__asm__ volatile("xgetbv" : "=a"(XCR0Low), "=d"(XCR0High) : "c"(0));
+			const uint64 XCR0 = ((uint64)XCR0High << 32) | XCR0Low;
+#endif
+			bOSSavesAVX = (XCR0 & 0x6) == 0x6;
+		}
+		OutProfile.bHasAVX = bOSSavesAVX && (Registers[2] & (1 << 28)) != 0;
+
+		if (MaxLeaf >= 7)
+		{
+#if defined(_MSC_VER)
+			__cpuidex((int32*)Registers, 7, 0);
+#else
+			__cpuid_count(7, 0, Registers[0], Registers[1], Registers[2], Registers[3]);
+#endif
+			OutProfile.bHasAVX2 = OutProfile.bHasAVX && (Registers[1] & (1 << 5)) != 0;
+		}
+#endif
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+		OutProfile.bHasNeon = true;
+#endif
+	}
+
+	static FAutoConsoleCommand LogProfileCommand(
+		TEXT("Extra.PlatformProfile"),
+		TEXT("Prints the platform profile the Extra Functionality plugin measured at startup, pass 1 to measure it again first."),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			if (Args.Num() > 0 && FCString::Atoi(*Args[0]) != 0)
+			{
+				FExtraPlatformProfiler::BuildProfile();
+			}
+			FExtraPlatformProfiler::LogProfile();
+		}));
+}
+
+const FExtraPlatformProfile& FExtraPlatformProfiler::GetProfile()
+{
+	if (!bProfileBuilt)
+	{
+		BuildProfile();
+	}
+	return Profile;
+}
+
+void FExtraPlatformProfiler::BuildProfile()
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	FExtraPlatformProfile NewProfile;
+	NewProfile.CPUBrand = FPlatformMisc::GetCPUBrand().TrimStartAndEnd();
+	NewProfile.NumPhysicalCores = FMath::Max(FPlatformMisc::NumberOfCores(), 1);
+	NewProfile.NumLogicalCores = FMath::Max(FPlatformMisc::NumberOfCoresIncludingHyperthreads(), NewProfile.NumPhysicalCores);
+	NewProfile.NumWorkerThreads = FApp::ShouldUseThreadingForPerformance() ? FPlatformMisc::NumberOfWorkerThreadsToSpawn() : 0;
+	NewProfile.CacheLineSize = FPlatformMisc::GetCacheLineSize();
+
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+	NewProfile.TotalPhysicalMemoryMB = (int32)(MemoryStats.TotalPhysical / (1024 * 1024));
+	NewProfile.AvailablePhysicalMemoryMB = (int32)(MemoryStats.AvailablePhysical / (1024 * 1024));
+
+	ExtraPlatformProfile::ReadCPUFeatures(NewProfile);
+
+	double BestSeconds = MAX_dbl;
+	for (int32 Round = 0; Round < ExtraPlatformProfile::BenchmarkRounds; Round++)
+	{
+		BestSeconds = FMath::Min(BestSeconds, RunBenchmarkRound());
+	}
+	NewProfile.CPUScore = GetBenchmarkScore(BestSeconds);
+	NewProfile.BenchmarkMs = (float)((FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	Profile = NewProfile;
+	bProfileBuilt = true;
+}
+
+void FExtraPlatformProfiler::LogProfile()
+{
+	const FExtraPlatformProfile& Current = GetProfile();
+	UE_LOG(LogExtraPlatformProfile, Display, TEXT("CPU: %s"), *Current.CPUBrand);
+	UE_LOG(LogExtraPlatformProfile, Display, TEXT("Cores: %d physical, %d logical, %d worker threads, %d byte cache lines"),
+		Current.NumPhysicalCores, Current.NumLogicalCores, Current.NumWorkerThreads, Current.CacheLineSize);
+	UE_LOG(LogExtraPlatformProfile, Display, TEXT("Memory: %d MB total, %d MB available at startup"),
+		Current.TotalPhysicalMemoryMB, Current.AvailablePhysicalMemoryMB);
+	UE_LOG(LogExtraPlatformProfile, Display, TEXT("SIMD: SSE4.2 %d, AVX %d, AVX2 %d, NEON %d"),
+		Current.bHasSSE42, Current.bHasAVX, Current.bHasAVX2, Current.bHasNeon);
+	UE_LOG(LogExtraPlatformProfile, Display, TEXT("CPU score: %.1f (measured in %.2f ms)"), Current.CPUScore, Current.BenchmarkMs);
+}
+
+double FExtraPlatformProfiler::RunBenchmarkRound()
+{
+	// Dependent float math mixed with integer hashing
+	volatile float Sink = 0.0f;
+	const double StartTime = FPlatformTime::Seconds();
+	float Value = 1.0f;
+	uint32 Hash = 2166136261u;
+	for (int32 index = 0; index < ExtraPlatformProfile::BenchmarkIterations; index++)
+	{
+		Hash = (Hash ^ (uint32)index) * 16777619u;
+		Value = FMath::Sqrt((Value * 1.0001f) + (float)(Hash & 255));
+	}
+	Sink = Value;
+	return FMath::Max(FPlatformTime::Seconds() - StartTime, (double)SMALL_NUMBER);
+}
+
+float FExtraPlatformProfiler::GetBenchmarkScore(double RoundSeconds)
+{
+	return (float)((ExtraPlatformProfile::BenchmarkReferenceSeconds / FMath::Max(RoundSeconds, (double)SMALL_NUMBER)) * 100.0);
+}
+
+int32 FExtraPlatformProfiler::GetBatchSize(int32 NumItems, int32 MinBatchSize)
+{
+	const int32 NumTasks = FMath::Max(GetProfile().NumWorkerThreads, 1) * ExtraPlatformProfile::BatchesPerWorker;
+	return FMath::Max(FMath::DivideAndRoundUp(NumItems, NumTasks), FMath::Max(MinBatchSize, 1));
+}
+
+bool FExtraPlatformProfiler::ShouldForceSingleThread(int32 NumItems, int32 MinItemsForParallel)
+{
+	return NumItems < MinItemsForParallel || GetProfile().NumWorkerThreads < 1;
+}
@@ -0,0 +1,127 @@
+#include "ExtraRenderDirtyQueue.h"
+#include "Components/ActorComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "ExtraMemoryTracking.h"
+
+DEFINE_LOG_CATEGORY(LogExtraRenderDirtyQueue);
+
+UExtraRenderDirtyQueueSubsystem::UExtraRenderDirtyQueueSubsystem()
+{
+}
+
+void UExtraRenderDirtyQueueSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UExtraRenderDirtyQueueSubsystem::OnWorldPostActorTick);
+}
+
+void UExtraRenderDirtyQueueSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	PostActorTickHandle.Reset();
+	Queue.Empty();
+
+	Super::Deinitialize();
+}
+
+UExtraRenderDirtyQueueSubsystem* UExtraRenderDirtyQueueSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (const UWorld* const World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull))
+	{
+		return World->GetSubsystem<UExtraRenderDirtyQueueSubsystem>();
+	}
+	return nullptr;
+}
+
+void UExtraRenderDirtyQueueSubsystem::QueueRenderDirty(UActorComponent* Component, EExtraRenderDirtyFlags Flags)
+{
+	EXTRA_LLM_SCOPE(Caches);
+	if (!Component || Flags == EExtraRenderDirtyFlags::None)
+	{
+		return;
+	}
+
+	Stats.NumMarks++;
+	if (EExtraRenderDirtyFlags* const QueuedFlags = Queue.Find(Component))
+	{
+		// Only redundant if it adds nothing, new flags on a queued component still cost work at the flush
+		if (EnumHasAllFlags(*QueuedFlags, Flags))
+		{
+			Stats.NumRedundantMarks++;
+		}
+		*QueuedFlags |= Flags;
+	}
+	else
+	{
+		Queue.Add(Component, Flags);
+	}
+}
+
+void UExtraRenderDirtyQueueSubsystem::K2_QueueRenderDirty(UActorComponent* Component, int32 Flags)
+{
+	QueueRenderDirty(Component, (EExtraRenderDirtyFlags)Flags);
+}
+
+void UExtraRenderDirtyQueueSubsystem::QueueRenderDirtyComponents(const TArray<UActorComponent*>& Components, int32 Flags)
+{
+	for (UActorComponent* const Component : Components)
+	{
+		QueueRenderDirty(Component, (EExtraRenderDirtyFlags)Flags);
+	}
+}
+
+void UExtraRenderDirtyQueueSubsystem::Flush()
+{
+	if (Queue.Num() == 0)
+	{
+		return;
+	}
+
+	Stats.NumFlushes++;
+	for (const TPair<TWeakObjectPtr<UActorComponent>, EExtraRenderDirtyFlags>& Pair : Queue)
+	{
+		UActorComponent* const Component = Pair.Key.Get();
+		if (!Component || Component->IsPendingKill())
+		{
+			continue;
+		}
+
+		Stats.NumFlushedComponents++;
+		if (EnumHasAnyFlags(Pair.Value, EExtraRenderDirtyFlags::RenderState))
+		{
+			// Recreating the render state sends the transform and dynamic data too
+			if (EnumHasAnyFlags(Pair.Value, EExtraRenderDirtyFlags::Transform | EExtraRenderDirtyFlags::DynamicData))
+			{
+				Stats.NumRedundantMarks++;
+			}
+			Component->MarkRenderStateDirty();
+			continue;
+		}
+
+		if (EnumHasAnyFlags(Pair.Value, EExtraRenderDirtyFlags::Transform))
+		{
+			Component->MarkRenderTransformDirty();
+		}
+		if (EnumHasAnyFlags(Pair.Value, EExtraRenderDirtyFlags::DynamicData))
+		{
+			Component->MarkRenderDynamicDataDirty();
+		}
+	}
+	Queue.Reset();
+}
+
+void UExtraRenderDirtyQueueSubsystem::ResetStats()
+{
+	Stats = FExtraRenderDirtyStats();
+}
+
+void UExtraRenderDirtyQueueSubsystem::OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	// The delegate is shared by every world
+	if (InWorld == GetWorld())
+	{
+		Flush();
+	}
+}
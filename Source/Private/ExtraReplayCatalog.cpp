@@ -0,0 +1,292 @@
+#include "ExtraReplayCatalog.h"
+#include "Async/Async.h"
+#include "ExtraMemoryTracking.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Misc/FileHelper.h"
+#include "Misc/NetworkVersion.h"
+#include "NetworkReplayStreaming/Public/NetworkReplayStreaming.h"
+#include "Paths.h"
+#include "Serialization/BufferArchive.h"
+#include "Serialization/MemoryReader.h"
+
+DEFINE_LOG_CATEGORY(LogExtraReplayCatalog);
+
+namespace ExtraReplayCatalog
+{
+	static const uint32 IndexMagic = 0x45524354; // "ERCT"
+	static const int32 IndexVersion = 1;
+
+	/** Keeps overlapping background writes from fighting over the index file */
+	static FCriticalSection IndexFileCritical;
+	/** Every snapshot gets the next number, so a write that was overtaken by a newer one is skipped */
+	static FThreadSafeCounter IndexSnapshotCounter;
+	/** Number of the snapshot last written, only touched while holding IndexFileCritical */
+	static int32 LastWrittenSnapshot = 0;
+
+	/** Only the header fields are written, users are written separately from the users map */
+	static void SerializeReplayInfo(FArchive& Ar, FExtraReplayInfo& Info)
+	{
+		bool bIsLive = Info.bIsLive;
+		Ar << Info.Name;
+		Ar << Info.FriendlyName;
+		Ar << Info.Timestamp;
+		Ar << Info.DurationInSeconds;
+		Ar << Info.SizeInBytes;
+		Ar << bIsLive;
+		Info.bIsLive = bIsLive;
+	}
+}
+
+UExtraReplayCatalogSubsystem::UExtraReplayCatalogSubsystem()
+{
+	MinRefreshInterval = 5.0f;
+	LastRefreshTime = -DBL_MAX;
+	bRefreshInProgress = false;
+}
+
+void UExtraReplayCatalogSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Populate from the last session right away so the list is usable before the streamer answers
+	LoadIndex();
+	RefreshCatalog(true);
+}
+
+void UExtraReplayCatalogSubsystem::Deinitialize()
+{
+	// Dropping the streamer cancels any pending enumeration callback
+	ReplayStreamer.Reset();
+	bRefreshInProgress = false;
+
+	Super::Deinitialize();
+}
+
+void UExtraReplayCatalogSubsystem::RefreshCatalog(bool bForce)
+{
+	EXTRA_LLM_SCOPE(Replays);
+	if (bRefreshInProgress)
+	{
+		// The pending refresh will broadcast when it finishes
+		return;
+	}
+
+	if (!bForce && (FPlatformTime::Seconds() - LastRefreshTime) < MinRefreshInterval)
+	{
+		OnCatalogRefreshed.Broadcast(true);
+		return;
+	}
+
+	// Reuse a single streamer for every refresh instead of creating one per replay
+	if (!ReplayStreamer.IsValid())
+	{
+		ReplayStreamer = FNetworkReplayStreaming::Get().GetFactory().CreateReplayStreamer();
+	}
+
+	if (!ReplayStreamer.IsValid())
+	{
+		UE_LOG(LogExtraReplayCatalog, Warning, TEXT("Failed to create a replay streamer to refresh the replay catalog"));
+		OnCatalogRefreshed.Broadcast(false);
+		return;
+	}
+
+	bRefreshInProgress = true;
+	ReplayStreamer->EnumerateStreams(FNetworkVersion::GetReplayVersion(), INDEX_NONE, FString(), TArray<FString>(),
+		FEnumerateStreamsCallback::CreateUObject(this, &UExtraReplayCatalogSubsystem::OnEnumerateStreamsComplete));
+}
+
+bool UExtraReplayCatalogSubsystem::FindReplay(const FString& ReplayName, FExtraReplayInfo& OutInfo) const
+{
+	if (const FExtraReplayInfo* Found = Replays.FindByPredicate([&ReplayName](const FExtraReplayInfo& Info) { return Info.Name == ReplayName; }))
+	{
+		OutInfo = *Found;
+		return true;
+	}
+	return false;
+}
+
+void UExtraReplayCatalogSubsystem::NotifyRecordingStarted(const FString& ReplayName)
+{
+	ActiveRecordingName = ReplayName;
+}
+
+void UExtraReplayCatalogSubsystem::NotifyRecordingStopped()
+{
+	ActiveRecordingName.Empty();
+
+	// The replay that just finished now has a final size and duration
+	RefreshCatalog(true);
+}
+
+void UExtraReplayCatalogSubsystem::NotifyUserAdded(const FString& UserString)
+{
+	// Replays with a streamer generated name can't be associated since we never got told the name
+	if (ActiveRecordingName.IsEmpty() || UserString.IsEmpty())
+	{
+		return;
+	}
+
+	ReplayUsers.FindOrAdd(ActiveRecordingName).AddUnique(UserString);
+
+	for (FExtraReplayInfo& Info : Replays)
+	{
+		if (Info.Name == ActiveRecordingName)
+		{
+			Info.Users.AddUnique(UserString);
+			break;
+		}
+	}
+	SaveIndexAsync();
+}
+
+void UExtraReplayCatalogSubsystem::OnEnumerateStreamsComplete(const FEnumerateStreamsResult& Result)
+{
+	EXTRA_LLM_SCOPE(Replays);
+	bRefreshInProgress = false;
+
+	if (!Result.WasSuccessful())
+	{
+		UE_LOG(LogExtraReplayCatalog, Warning, TEXT("Replay streamer failed to enumerate replays, keeping the cached catalog"));
+		OnCatalogRefreshed.Broadcast(false);
+		return;
+	}
+
+	LastRefreshTime = FPlatformTime::Seconds();
+
+	Replays.Reset(Result.FoundStreams.Num());
+	for (const FNetworkReplayStreamInfo& StreamInfo : Result.FoundStreams)
+	{
+		FExtraReplayInfo& Info = Replays.AddDefaulted_GetRef();
+		Info.Name = StreamInfo.Name;
+		Info.FriendlyName = StreamInfo.FriendlyName;
+		Info.Timestamp = StreamInfo.Timestamp;
+		Info.DurationInSeconds = StreamInfo.LengthInMS / 1000.0f;
+		Info.SizeInBytes = StreamInfo.SizeInBytes;
+		Info.bIsLive = StreamInfo.bIsLive;
+
+		if (const TArray<FString>* Users = ReplayUsers.Find(Info.Name))
+		{
+			Info.Users = *Users;
+		}
+	}
+
+	// Forget users of replays that no longer exist
+	for (auto It = ReplayUsers.CreateIterator(); It; ++It)
+	{
+		if (It.Key() != ActiveRecordingName && !Replays.ContainsByPredicate([&It](const FExtraReplayInfo& Info) { return Info.Name == It.Key(); }))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	Replays.Sort([](const FExtraReplayInfo& A, const FExtraReplayInfo& B)
+	{
+		return (A.Timestamp > B.Timestamp);
+	});
+
+	UE_LOG(LogExtraReplayCatalog, Verbose, TEXT("Replay catalog refreshed, found %d replays"), Replays.Num());
+
+	SaveIndexAsync();
+	OnCatalogRefreshed.Broadcast(true);
+}
+
+FString UExtraReplayCatalogSubsystem::GetIndexFilePath() const
+{
+	return FPaths::ProjectSavedDir() / TEXT("ExtraFunctionality") / TEXT("ReplayCatalog.bin");
+}
+
+void UExtraReplayCatalogSubsystem::LoadIndex()
+{
+	EXTRA_LLM_SCOPE(Replays);
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *GetIndexFilePath(), FILEREAD_Silent))
+	{
+		return;
+	}
+
+	FMemoryReader Reader(Data);
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	Reader << Magic;
+	Reader << Version;
+	if (Magic != ExtraReplayCatalog::IndexMagic || Version != ExtraReplayCatalog::IndexVersion)
+	{
+		UE_LOG(LogExtraReplayCatalog, Display, TEXT("Ignoring out of date replay catalog index: %s"), *GetIndexFilePath());
+		return;
+	}
+
+	int32 NumReplays = 0;
+	Reader << NumReplays;
+
+	// Every entry takes at least a byte so anything bigger than the file means it's corrupt
+	if (NumReplays < 0 || NumReplays > Data.Num())
+	{
+		UE_LOG(LogExtraReplayCatalog, Warning, TEXT("Replay catalog index is corrupt, it will be rebuilt: %s"), *GetIndexFilePath());
+		return;
+	}
+
+	TArray<FExtraReplayInfo> LoadedReplays;
+	LoadedReplays.SetNum(NumReplays);
+	for (FExtraReplayInfo& Info : LoadedReplays)
+	{
+		ExtraReplayCatalog::SerializeReplayInfo(Reader, Info);
+	}
+
+	TMap<FString, TArray<FString>> LoadedUsers;
+	Reader << LoadedUsers;
+
+	if (Reader.IsError())
+	{
+		UE_LOG(LogExtraReplayCatalog, Warning, TEXT("Replay catalog index is corrupt, it will be rebuilt: %s"), *GetIndexFilePath());
+		return;
+	}
+
+	for (FExtraReplayInfo& Info : LoadedReplays)
+	{
+		if (const TArray<FString>* Users = LoadedUsers.Find(Info.Name))
+		{
+			Info.Users = *Users;
+		}
+	}
+
+	Replays = MoveTemp(LoadedReplays);
+	ReplayUsers = MoveTemp(LoadedUsers);
+}
+
+void UExtraReplayCatalogSubsystem::SaveIndexAsync() const
+{
+	EXTRA_LLM_SCOPE(Replays);
+	FBufferArchive Writer;
+
+	uint32 Magic = ExtraReplayCatalog::IndexMagic;
+	int32 Version = ExtraReplayCatalog::IndexVersion;
+	int32 NumReplays = Replays.Num();
+	Writer << Magic;
+	Writer << Version;
+	Writer << NumReplays;
+	for (const FExtraReplayInfo& Info : Replays)
+	{
+		ExtraReplayCatalog::SerializeReplayInfo(Writer, const_cast<FExtraReplayInfo&>(Info));
+	}
+	Writer << const_cast<TMap<FString, TArray<FString>>&>(ReplayUsers);
+
+	// Only the file write happens off the game thread, the data was already copied into the buffer
+	const int32 Snapshot = ExtraReplayCatalog::IndexSnapshotCounter.Increment();
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Data = TArray<uint8>(MoveTemp(Writer)), FilePath = GetIndexFilePath(), Snapshot]()
+	{
+		FScopeLock Lock(&ExtraReplayCatalog::IndexFileCritical);
+
+		// Tasks can run in any order, an older snapshot must not replace a newer one that's already on disk
+		if (Snapshot < ExtraReplayCatalog::LastWrittenSnapshot)
+		{
+			return;
+		}
+		ExtraReplayCatalog::LastWrittenSnapshot = Snapshot;
+
+		if (!FFileHelper::SaveArrayToFile(Data, *FilePath))
+		{
+			UE_LOG(LogExtraReplayCatalog, Warning, TEXT("Failed to write replay catalog index: %s"), *FilePath);
+		}
+	});
+}
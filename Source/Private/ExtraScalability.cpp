@@ -0,0 +1,240 @@
+#include "ExtraScalability.h"
+#include "Async/ParallelFor.h"
+#include "Engine/Engine.h"
+#include "ExtraPlatformProfile.h"
+#include "GameFramework/GameUserSettings.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Paths.h"
+#include "Serialization/BufferArchive.h"
+#include "Serialization/MemoryReader.h"
+
+DEFINE_LOG_CATEGORY(LogExtraScalability);
+
+FExtraCPUBenchmarkResult FExtraScalability::Result;
+FExtraScalabilityTier FExtraScalability::ActiveTier;
+bool FExtraScalability::bHasActiveTier = false;
+
+namespace ExtraScalability
+{
+	static const uint32 CacheMagic = 0x45434242; // "ECBB"
+	static const int32 CacheVersion = 1;
+	static const int32 BenchmarkRounds = 3;
+
+	/** The editor, commandlets and dedicated servers don't get auto configured, they'd change and save the developer's or server's settings */
+	static bool CanAutoConfigure()
+	{
+		return !GIsEditor && !IsRunningCommandlet() && !IsRunningDedicatedServer();
+	}
+
+	/** The hardware the cached result was measured on, a mismatch runs the benchmark again */
+	static FString MakeHardwareKey()
+	{
+		const FExtraPlatformProfile& Profile = FExtraPlatformProfiler::GetProfile();
+		return FString::Printf(TEXT("%s|%d|%d"), *Profile.CPUBrand, Profile.NumLogicalCores, Profile.NumWorkerThreads);
+	}
+
+	static FAutoConsoleCommand RunBenchmarkCommand(
+		TEXT("Extra.RunCPUBenchmark"),
+		TEXT("Runs the Extra Functionality CPU benchmark again, ignoring the cached result, and applies the tier it picks."),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			FExtraScalability::RunBenchmark(true);
+			FExtraScalability::SelectTier();
+			FExtraScalability::ApplyScalabilityLevel();
+		}));
+}
+
+UExtraScalabilitySettings::UExtraScalabilitySettings()
+{
+	bAutoConfigureAtStartup = true;
+	bApplyScalabilityLevel = true;
+	MultiThreadWeight = 0.5f;
+
+	Tiers.Add(FExtraScalabilityTier(TEXT("Low"), 0.0f, 0, 1.0f, 32));
+	Tiers.Add(FExtraScalabilityTier(TEXT("Medium"), 60.0f, 1, 2.0f, 64));
+	Tiers.Add(FExtraScalabilityTier(TEXT("High"), 120.0f, 2, 3.0f, 128));
+	Tiers.Add(FExtraScalabilityTier(TEXT("Epic"), 200.0f, 3, 4.0f, 0));
+}
+
+void FExtraScalability::AutoConfigure()
+{
+	const UExtraScalabilitySettings* const Settings = GetDefault<UExtraScalabilitySettings>();
+	if (!Settings->bAutoConfigureAtStartup || !ExtraScalability::CanAutoConfigure())
+	{
+		return;
+	}
+
+	RunBenchmark(false);
+	SelectTier();
+}
+
+void FExtraScalability::ApplyStartupScalabilityLevel()
+{
+	const UExtraScalabilitySettings* const Settings = GetDefault<UExtraScalabilitySettings>();
+
+	// Only a fresh measurement overrides the scalability level, a cached one means it was already applied once
+	if (Settings->bAutoConfigureAtStartup && Settings->bApplyScalabilityLevel && !Result.bFromCache && ExtraScalability::CanAutoConfigure())
+	{
+		ApplyScalabilityLevel();
+	}
+}
+
+const FExtraCPUBenchmarkResult& FExtraScalability::RunBenchmark(bool bForce)
+{
+	FExtraCPUBenchmarkResult NewResult;
+	if (!bForce && LoadCache(NewResult))
+	{
+		NewResult.bFromCache = true;
+		Result = NewResult;
+		return Result;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	double BestSingleSeconds = MAX_dbl;
+	for (int32 Round = 0; Round < ExtraScalability::BenchmarkRounds; Round++)
+	{
+		BestSingleSeconds = FMath::Min(BestSingleSeconds, FExtraPlatformProfiler::RunBenchmarkRound());
+	}
+
+	// Every worker plus the calling thread runs a round at once, so the wall time shows how well the work spreads
+	const int32 NumTasks = FExtraPlatformProfiler::GetProfile().NumWorkerThreads + 1;
+	double BestMultiSeconds = MAX_dbl;
+	for (int32 Round = 0; Round < ExtraScalability::BenchmarkRounds; Round++)
+	{
+		const double RoundStart = FPlatformTime::Seconds();
+		ParallelFor(NumTasks, [](int32 TaskIndex)
+		{
+			FExtraPlatformProfiler::RunBenchmarkRound();
+		}, NumTasks == 1);
+		BestMultiSeconds = FMath::Min(BestMultiSeconds, FPlatformTime::Seconds() - RoundStart);
+	}
+
+	const float MultiThreadWeight = GetDefault<UExtraScalabilitySettings>()->MultiThreadWeight;
+	NewResult.SingleThreadScore = FExtraPlatformProfiler::GetBenchmarkScore(BestSingleSeconds);
+	NewResult.MultiThreadScore = FExtraPlatformProfiler::GetBenchmarkScore(BestMultiSeconds) * NumTasks;
+	NewResult.CombinedScore = FMath::Lerp(NewResult.SingleThreadScore, NewResult.MultiThreadScore, MultiThreadWeight);
+	NewResult.BenchmarkMs = (float)((FPlatformTime::Seconds() - StartTime) * 1000.0);
+	NewResult.bFromCache = false;
+
+	UE_LOG(LogExtraScalability, Log, TEXT("CPU benchmark: single thread %.1f, multi thread %.1f, combined %.1f (%.2f ms)"),
+		NewResult.SingleThreadScore, NewResult.MultiThreadScore, NewResult.CombinedScore, NewResult.BenchmarkMs);
+
+	Result = NewResult;
+	SaveCache(Result);
+	return Result;
+}
+
+void FExtraScalability::SelectTier()
+{
+	const TArray<FExtraScalabilityTier>& Tiers = GetDefault<UExtraScalabilitySettings>()->Tiers;
+
+	// The tiers don't have to be in order, pick the highest one the score reaches
+	int32 TierIndex = INDEX_NONE;
+	for (int32 index = 0; index < Tiers.Num(); index++)
+	{
+		if (Result.CombinedScore >= Tiers[index].MinScore && (TierIndex == INDEX_NONE || Tiers[index].MinScore > Tiers[TierIndex].MinScore))
+		{
+			TierIndex = index;
+		}
+	}
+
+	Result.TierIndex = TierIndex;
+	bHasActiveTier = (TierIndex != INDEX_NONE);
+	if (!bHasActiveTier)
+	{
+		return;
+	}
+
+	ActiveTier = Tiers[TierIndex];
+	UE_LOG(LogExtraScalability, Log, TEXT("Picked scalability tier %s for CPU score %.1f"), *ActiveTier.TierName.ToString(), Result.CombinedScore);
+}
+
+void FExtraScalability::ApplyScalabilityLevel()
+{
+	UGameUserSettings* const UserSettings = (bHasActiveTier && GEngine) ? GEngine->GetGameUserSettings() : nullptr;
+	if (UserSettings)
+	{
+		UserSettings->SetOverallScalabilityLevel(FMath::Clamp(ActiveTier.ScalabilityLevel, 0, 3));
+		UserSettings->ApplySettings(false);
+	}
+}
+
+const FExtraScalabilityTier* FExtraScalability::GetActiveTier()
+{
+	return bHasActiveTier ? &ActiveTier : nullptr;
+}
+
+float FExtraScalability::GetSplineBuildBudgetMs(float Default)
+{
+	return bHasActiveTier ? ActiveTier.SplineBuildBudgetMs : Default;
+}
+
+int32 FExtraScalability::GetTracesPerFrame(int32 Default)
+{
+	return bHasActiveTier ? ActiveTier.TracesPerFrame : Default;
+}
+
+FString FExtraScalability::GetCacheFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("ExtraFunctionality") / TEXT("CPUBenchmark.bin");
+}
+
+bool FExtraScalability::LoadCache(FExtraCPUBenchmarkResult& OutResult)
+{
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *GetCacheFilePath(), FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Data);
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	FString HardwareKey;
+	Reader << Magic;
+	Reader << Version;
+	if (Magic != ExtraScalability::CacheMagic || Version != ExtraScalability::CacheVersion)
+	{
+		return false;
+	}
+
+	Reader << HardwareKey;
+	Reader << OutResult.SingleThreadScore;
+	Reader << OutResult.MultiThreadScore;
+	Reader << OutResult.BenchmarkMs;
+	if (Reader.IsError() || HardwareKey != ExtraScalability::MakeHardwareKey())
+	{
+		return false;
+	}
+
+	// Blended again in case the weight was changed since the cache was written
+	OutResult.CombinedScore = FMath::Lerp(OutResult.SingleThreadScore, OutResult.MultiThreadScore,
+		GetDefault<UExtraScalabilitySettings>()->MultiThreadWeight);
+	return true;
+}
+
+void FExtraScalability::SaveCache(const FExtraCPUBenchmarkResult& InResult)
+{
+	FBufferArchive Writer;
+
+	uint32 Magic = ExtraScalability::CacheMagic;
+	int32 Version = ExtraScalability::CacheVersion;
+	FString HardwareKey = ExtraScalability::MakeHardwareKey();
+	float SingleThreadScore = InResult.SingleThreadScore;
+	float MultiThreadScore = InResult.MultiThreadScore;
+	float BenchmarkMs = InResult.BenchmarkMs;
+	Writer << Magic;
+	Writer << Version;
+	Writer << HardwareKey;
+	Writer << SingleThreadScore;
+	Writer << MultiThreadScore;
+	Writer << BenchmarkMs;
+
+	if (!FFileHelper::SaveArrayToFile(Writer, *GetCacheFilePath()))
+	{
+		UE_LOG(LogExtraScalability, Warning, TEXT("Failed to write CPU benchmark cache: %s"), *GetCacheFilePath());
+	}
+}
@@ -0,0 +1,429 @@
+#include "ExtraSplineFollower.h"
+#include "Async/ParallelFor.h"
+#include "Components/SplineComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "ExtraMemoryTracking.h"
+#include "ExtraPlatformProfile.h"
+#include "ExtraSplineSampleTable.h"
+#include "GameFramework/Actor.h"
+
+DEFINE_LOG_CATEGORY(LogExtraSplineFollower);
+
+namespace ExtraSplineFollower
+{
+	/** Below this many followers it's faster to stay on the game thread than to wake up workers */
+	static const int32 MinFollowersForParallel = 64;
+	/** Fewest followers per worker task, the actual batch size grows with the number of followers */
+	static const int32 MinFollowersPerBatch = 32;
+}
+
+UExtraSplineFollowerComponent::UExtraSplineFollowerComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+
+	SplineActor = nullptr;
+	Speed = 100.0f;
+	StartDistance = 0.0f;
+	EndBehavior = EExtraSplineFollowEndBehavior::Loop;
+	bFollowRotation = true;
+	Spline = nullptr;
+	FollowerIndex = INDEX_NONE;
+}
+
+void UExtraSplineFollowerComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (!Spline && SplineActor)
+	{
+		Spline = SplineActor->FindComponentByClass<USplineComponent>();
+	}
+
+	if (UExtraSplineFollowerSubsystem* const Subsystem = UExtraSplineFollowerSubsystem::Get(this))
+	{
+		Subsystem->RegisterFollower(this);
+	}
+}
+
+void UExtraSplineFollowerComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UExtraSplineFollowerSubsystem* const Subsystem = UExtraSplineFollowerSubsystem::Get(this))
+	{
+		Subsystem->UnregisterFollower(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UExtraSplineFollowerComponent::SetSpline(USplineComponent* SplineComp)
+{
+	Spline = SplineComp;
+	if (UExtraSplineFollowerSubsystem* const Subsystem = UExtraSplineFollowerSubsystem::Get(this))
+	{
+		Subsystem->SetFollowerSpline(this, SplineComp);
+	}
+}
+
+void UExtraSplineFollowerComponent::SetSpeed(float NewSpeed)
+{
+	Speed = NewSpeed;
+	if (UExtraSplineFollowerSubsystem* const Subsystem = UExtraSplineFollowerSubsystem::Get(this))
+	{
+		Subsystem->SetFollowerSpeed(this, NewSpeed);
+	}
+}
+
+float UExtraSplineFollowerComponent::GetSpeed() const
+{
+	const UExtraSplineFollowerSubsystem* const Subsystem = UExtraSplineFollowerSubsystem::Get(this);
+	return Subsystem ? Subsystem->GetFollowerSpeed(this) : Speed;
+}
+
+void UExtraSplineFollowerComponent::SetDistance(float NewDistance)
+{
+	if (UExtraSplineFollowerSubsystem* const Subsystem = UExtraSplineFollowerSubsystem::Get(this))
+	{
+		Subsystem->SetFollowerDistance(this, NewDistance);
+	}
+	if (FollowerIndex == INDEX_NONE)
+	{
+		StartDistance = NewDistance;
+	}
+}
+
+float UExtraSplineFollowerComponent::GetDistance() const
+{
+	const UExtraSplineFollowerSubsystem* const Subsystem = UExtraSplineFollowerSubsystem::Get(this);
+	return Subsystem ? Subsystem->GetFollowerDistance(this) : StartDistance;
+}
+
+void UExtraSplineFollowerComponent::SetEndBehavior(EExtraSplineFollowEndBehavior NewEndBehavior)
+{
+	EndBehavior = NewEndBehavior;
+	if (UExtraSplineFollowerSubsystem* const Subsystem = UExtraSplineFollowerSubsystem::Get(this))
+	{
+		Subsystem->SetFollowerEndBehavior(this, NewEndBehavior);
+	}
+}
+
+void UExtraSplineFollowerComponent::SetFollowRotation(bool bNewFollowRotation)
+{
+	bFollowRotation = bNewFollowRotation;
+	if (UExtraSplineFollowerSubsystem* const Subsystem = UExtraSplineFollowerSubsystem::Get(this))
+	{
+		Subsystem->SetFollowerRotation(this, bNewFollowRotation);
+	}
+}
+
+UExtraSplineFollowerSubsystem::UExtraSplineFollowerSubsystem()
+{
+	MaxPositionError = 1.0f;
+}
+
+void UExtraSplineFollowerSubsystem::Deinitialize()
+{
+	for (UExtraSplineFollowerComponent* const Follower : Followers)
+	{
+		if (Follower)
+		{
+			Follower->FollowerIndex = INDEX_NONE;
+		}
+	}
+	Followers.Empty();
+	TableIndices.Empty();
+	Distances.Empty();
+	Speeds.Empty();
+	EndBehaviors.Empty();
+	FollowRotations.Empty();
+	Transforms.Empty();
+	Moved.Empty();
+	ReachedEnd.Empty();
+	Tables.Empty();
+	TableRefCounts.Empty();
+	FreeTables.Empty();
+	TableLookup.Empty();
+
+	Super::Deinitialize();
+}
+
+UExtraSplineFollowerSubsystem* UExtraSplineFollowerSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (const UWorld* const World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull))
+	{
+		return World->GetSubsystem<UExtraSplineFollowerSubsystem>();
+	}
+	return nullptr;
+}
+
+void UExtraSplineFollowerSubsystem::RegisterFollower(UExtraSplineFollowerComponent* Follower)
+{
+	if (!Follower || IsRegistered(Follower))
+	{
+		return;
+	}
+
+	Follower->FollowerIndex = Followers.Add(Follower);
+	TableIndices.Add(Follower->Spline ? FindOrAddTable(Follower->Spline) : INDEX_NONE);
+	Distances.Add(Follower->StartDistance);
+	Speeds.Add(Follower->Speed);
+	EndBehaviors.Add(Follower->EndBehavior);
+	FollowRotations.Add(Follower->bFollowRotation);
+	Transforms.AddDefaulted();
+	Moved.Add(false);
+	ReachedEnd.Add(false);
+}
+
+void UExtraSplineFollowerSubsystem::UnregisterFollower(UExtraSplineFollowerComponent* Follower)
+{
+	if (!IsRegistered(Follower))
+	{
+		return;
+	}
+
+	// Swap the last follower into the hole so the arrays stay packed
+	const int32 Index = Follower->FollowerIndex;
+	ReleaseTable(TableIndices[Index]);
+	Followers.RemoveAtSwap(Index, 1, false);
+	TableIndices.RemoveAtSwap(Index, 1, false);
+	Distances.RemoveAtSwap(Index, 1, false);
+	Speeds.RemoveAtSwap(Index, 1, false);
+	EndBehaviors.RemoveAtSwap(Index, 1, false);
+	FollowRotations.RemoveAtSwap(Index, 1, false);
+	Transforms.RemoveAtSwap(Index, 1, false);
+	Moved.RemoveAtSwap(Index, 1, false);
+	ReachedEnd.RemoveAtSwap(Index, 1, false);
+
+	if (Followers.IsValidIndex(Index) && Followers[Index])
+	{
+		Followers[Index]->FollowerIndex = Index;
+	}
+	Follower->FollowerIndex = INDEX_NONE;
+}
+
+void UExtraSplineFollowerSubsystem::SetFollowerSpline(UExtraSplineFollowerComponent* Follower, USplineComponent* SplineComp)
+{
+	if (IsRegistered(Follower))
+	{
+		// Referenced before the old table is released so switching to the same spline doesn't rebuild its table
+		const int32 OldTableIndex = TableIndices[Follower->FollowerIndex];
+		TableIndices[Follower->FollowerIndex] = SplineComp ? FindOrAddTable(SplineComp) : INDEX_NONE;
+		ReleaseTable(OldTableIndex);
+	}
+}
+
+void UExtraSplineFollowerSubsystem::SetFollowerSpeed(UExtraSplineFollowerComponent* Follower, float Speed)
+{
+	if (IsRegistered(Follower))
+	{
+		Speeds[Follower->FollowerIndex] = Speed;
+	}
+}
+
+void UExtraSplineFollowerSubsystem::SetFollowerDistance(UExtraSplineFollowerComponent* Follower, float Distance)
+{
+	if (IsRegistered(Follower))
+	{
+		Distances[Follower->FollowerIndex] = Distance;
+	}
+}
+
+void UExtraSplineFollowerSubsystem::SetFollowerEndBehavior(UExtraSplineFollowerComponent* Follower, EExtraSplineFollowEndBehavior EndBehavior)
+{
+	if (IsRegistered(Follower))
+	{
+		EndBehaviors[Follower->FollowerIndex] = EndBehavior;
+	}
+}
+
+void UExtraSplineFollowerSubsystem::SetFollowerRotation(UExtraSplineFollowerComponent* Follower, bool bFollowRotation)
+{
+	if (IsRegistered(Follower))
+	{
+		FollowRotations[Follower->FollowerIndex] = bFollowRotation;
+	}
+}
+
+float UExtraSplineFollowerSubsystem::GetFollowerSpeed(const UExtraSplineFollowerComponent* Follower) const
+{
+	return IsRegistered(Follower) ? Speeds[Follower->FollowerIndex] : (Follower ? Follower->Speed : 0.0f);
+}
+
+float UExtraSplineFollowerSubsystem::GetFollowerDistance(const UExtraSplineFollowerComponent* Follower) const
+{
+	return IsRegistered(Follower) ? Distances[Follower->FollowerIndex] : (Follower ? Follower->StartDistance : 0.0f);
+}
+
+void UExtraSplineFollowerSubsystem::Tick(float DeltaTime)
+{
+	EXTRA_LLM_SCOPE(Splines);
+	// Tables are rebuilt and their spline info fetched once up front, the parallel pass only reads them
+	TArray<FTransform, TInlineAllocator<16>> TableTransforms;
+	TArray<float, TInlineAllocator<16>> TableLengths;
+	TArray<bool, TInlineAllocator<16>> TableValid;
+	TableTransforms.SetNum(Tables.Num());
+	TableLengths.SetNum(Tables.Num());
+	TableValid.SetNum(Tables.Num());
+	for (int32 index = 0; index < Tables.Num(); index++)
+	{
+		UExtraSplineSampleTable* const Table = Tables[index];
+		if (Table)
+		{
+			Table->ConditionalRebuild();
+		}
+		TableValid[index] = Table && Table->IsValidTable();
+		TableTransforms[index] = TableValid[index] ? Table->GetComponentTransform() : FTransform::Identity;
+		TableLengths[index] = TableValid[index] ? Table->GetSplineLength() : 0.0f;
+	}
+
+	const int32 NumFollowers = Followers.Num();
+	const int32 BatchSize = FExtraPlatformProfiler::GetBatchSize(NumFollowers, ExtraSplineFollower::MinFollowersPerBatch);
+	const int32 NumBatches = FMath::DivideAndRoundUp(NumFollowers, BatchSize);
+	ParallelFor(NumBatches, [&](int32 BatchIndex)
+	{
+		const int32 FirstIndex = BatchIndex * BatchSize;
+		const int32 LastIndex = FMath::Min(FirstIndex + BatchSize, NumFollowers);
+		for (int32 index = FirstIndex; index < LastIndex; index++)
+		{
+			const int32 TableIndex = TableIndices[index];
+			Moved[index] = TableValid.IsValidIndex(TableIndex) && TableValid[TableIndex];
+			ReachedEnd[index] = false;
+			if (!Moved[index])
+			{
+				continue;
+			}
+
+			const float Length = TableLengths[TableIndex];
+			const float PreviousDistance = Distances[index];
+			float Distance = PreviousDistance + (Speeds[index] * DeltaTime);
+			switch (EndBehaviors[index])
+			{
+			case EExtraSplineFollowEndBehavior::Loop:
+				if (Distance > Length || Distance < 0.0f)
+				{
+					ReachedEnd[index] = true;
+					Distance = (Length > 0.0f) ? FMath::Fmod(Distance, Length) : 0.0f;
+					Distance += (Distance < 0.0f) ? Length : 0.0f;
+				}
+				break;
+			case EExtraSplineFollowEndBehavior::PingPong:
+				if (Distance > Length || Distance < 0.0f)
+				{
+					ReachedEnd[index] = true;
+					Distance = (Distance > Length) ? ((2.0f * Length) - Distance) : -Distance;
+					Distance = FMath::Clamp(Distance, 0.0f, Length);
+					Speeds[index] = -Speeds[index];
+				}
+				break;
+			default:
+				Distance = FMath::Clamp(Distance, 0.0f, Length);
+				ReachedEnd[index] = (Distance != PreviousDistance) && (Distance == Length || Distance == 0.0f);
+				break;
+			}
+			Distances[index] = Distance;
+
+			FTransform Transform = UExtraSplineSampleTable::SampleToTransform(Tables[TableIndex]->SampleAtDistance(Distance),
+				ESplineCoordinateSpace::World, TableTransforms[TableIndex], false);
+			// Face the way we're going when heading back towards the start
+			if (Speeds[index] < 0.0f)
+			{
+				Transform.SetRotation(Transform.GetRotation() * FQuat(FVector::UpVector, PI));
+			}
+			Transforms[index] = Transform;
+		}
+	}, FExtraPlatformProfiler::ShouldForceSingleThread(NumFollowers, ExtraSplineFollower::MinFollowersForParallel));
+
+	// Write everything back in one pass, events are gathered and called after since they can register or unregister followers
+	TArray<UExtraSplineFollowerComponent*, TInlineAllocator<16>> FinishedFollowers;
+	for (int32 index = 0; index < NumFollowers; index++)
+	{
+		UExtraSplineFollowerComponent* const Follower = Followers[index];
+		if (!Moved[index] || !Follower)
+		{
+			continue;
+		}
+
+		USceneComponent* const Root = Follower->GetOwner() ? Follower->GetOwner()->GetRootComponent() : nullptr;
+		if (Root)
+		{
+			if (FollowRotations[index])
+			{
+				Root->SetWorldLocationAndRotation(Transforms[index].GetLocation(), Transforms[index].GetRotation(), false, nullptr, ETeleportType::TeleportPhysics);
+			}
+			else
+			{
+				Root->SetWorldLocation(Transforms[index].GetLocation(), false, nullptr, ETeleportType::TeleportPhysics);
+			}
+		}
+
+		if (ReachedEnd[index])
+		{
+			FinishedFollowers.Add(Follower);
+		}
+	}
+
+	for (UExtraSplineFollowerComponent* const Follower : FinishedFollowers)
+	{
+		Follower->OnReachedEnd.Broadcast(Follower);
+	}
+}
+
+TStatId UExtraSplineFollowerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UExtraSplineFollowerSubsystem, STATGROUP_Tickables);
+}
+
+int32 UExtraSplineFollowerSubsystem::FindOrAddTable(USplineComponent* SplineComp)
+{
+	if (const int32* const ExistingIndex = TableLookup.Find(SplineComp))
+	{
+		if (Tables.IsValidIndex(*ExistingIndex) && Tables[*ExistingIndex])
+		{
+			TableRefCounts[*ExistingIndex]++;
+			return *ExistingIndex;
+		}
+	}
+
+	UExtraSplineSampleTable* const Table = UExtraSplineSampleTable::CreateSplineSampleTable(SplineComp, MaxPositionError);
+	int32 TableIndex;
+	if (FreeTables.Num() > 0)
+	{
+		TableIndex = FreeTables.Pop(false);
+		Tables[TableIndex] = Table;
+		TableRefCounts[TableIndex] = 1;
+	}
+	else
+	{
+		TableIndex = Tables.Add(Table);
+		TableRefCounts.Add(1);
+	}
+	TableLookup.Add(SplineComp, TableIndex);
+	UE_LOG(LogExtraSplineFollower, Verbose, TEXT("Created sample table for followers of %s"), *GetNameSafe(SplineComp));
+	return TableIndex;
+}
+
+void UExtraSplineFollowerSubsystem::ReleaseTable(int32 TableIndex)
+{
+	if (!TableRefCounts.IsValidIndex(TableIndex) || TableRefCounts[TableIndex] <= 0 || --TableRefCounts[TableIndex] > 0)
+	{
+		return;
+	}
+
+	// Searched by index since the spline could already be destroyed
+	for (auto It = TableLookup.CreateIterator(); It; ++It)
+	{
+		if (It.Value() == TableIndex)
+		{
+			It.RemoveCurrent();
+			break;
+		}
+	}
+	UE_LOG(LogExtraSplineFollower, Verbose, TEXT("Released sample table %s, no followers use it anymore"), *GetNameSafe(Tables[TableIndex]));
+	Tables[TableIndex] = nullptr;
+	FreeTables.Add(TableIndex);
+}
+
+bool UExtraSplineFollowerSubsystem::IsRegistered(const UExtraSplineFollowerComponent* Follower) const
+{
+	return Follower && Followers.IsValidIndex(Follower->FollowerIndex) && Followers[Follower->FollowerIndex] == Follower;
+}
@@ -0,0 +1,393 @@
+#include "ExtraSplineMeshBuilder.h"
+#include "Components/BoxComponent.h"
+#include "Components/SplineComponent.h"
+#include "Components/SplineMeshComponent.h"
+#include "DrawDebugHelpers.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "ExtraDebugDraw.h"
+#include "ExtraFunctionalityLibrary.h"
+#include "ExtraMemoryTracking.h"
+#include "ExtraSplineMeshPool.h"
+
+DEFINE_LOG_CATEGORY(LogExtraSplineMeshBuilder);
+
+const FName FExtraSplineMeshBuilder::CollisionBodyTag(TEXT("ExtraSplineCollision"));
+
+void FExtraSplineMeshBuilder::ComputeTiles(USplineComponent* SplineComp, const FExtraSplineConstructionInfo& ConstructionInfo, TArray<FExtraSplineMeshTile>& OutTiles)
+{
+	EXTRA_LLM_SCOPE(SplineMeshes);
+	OutTiles.Reset();
+	if (!SplineComp || ConstructionInfo.SplineTileLength <= 0.0f)
+	{
+		return;
+	}
+
+	// Base the up vector for each spline point
+	for (int32 index = 0; index < (SplineComp->GetNumberOfSplinePoints() - 1); index++)
+	{
+		if (!UExtraFunctionalityLibrary::IsValidSplinePoint(SplineComp, index))
+		{
+			break;
+		}
+		SplineComp->SetUpVectorAtSplinePoint(index,
+			FRotationMatrix(
+				SplineComp->GetRotationAtSplinePoint(index, ESplineCoordinateSpace::World)).GetScaledAxis(EAxis::Z),
+			ESplineCoordinateSpace::World);
+	}
+
+	const float SplineLength = SplineComp->GetSplineLength();
+	const int32 SplineEndAmount = (FMath::TruncToInt(SplineLength / ConstructionInfo.SplineTileLength) + 1);
+	OutTiles.Reserve(SplineEndAmount);
+
+	for (int32 index = 0; index < SplineEndAmount; index++)
+	{
+		const float CurrentDistance = index * ConstructionInfo.SplineTileLength;
+		const float NextDistance = FMath::Clamp((index + 1) * ConstructionInfo.SplineTileLength, 0.0f, SplineLength);
+		const float MidPointSplineDistance = (CurrentDistance + NextDistance) * 0.5f;
+		const float CurrentTileLength = NextDistance - CurrentDistance;
+		const FRotator MidPointRotation = SplineComp->GetRotationAtDistanceAlongSpline(MidPointSplineDistance, ESplineCoordinateSpace::Local);
+
+		FExtraSplineMeshTile& Tile = OutTiles.AddDefaulted_GetRef();
+		Tile.MidPointDistance = MidPointSplineDistance;
+		Tile.UpDir = FRotationMatrix(MidPointRotation).GetScaledAxis(EAxis::Z);
+
+		// Start & end
+		const FVector SplineStartTangent = SplineComp->GetTangentAtDistanceAlongSpline(CurrentDistance, ESplineCoordinateSpace::Local);
+		Tile.StartTangent = SplineStartTangent.GetSafeNormal() * FMath::Min(SplineStartTangent.Size(), CurrentTileLength);
+		Tile.StartLocation = SplineComp->GetLocationAtDistanceAlongSpline(CurrentDistance, ESplineCoordinateSpace::Local);
+
+		const FVector SplineEndTangent = SplineComp->GetTangentAtDistanceAlongSpline(NextDistance, ESplineCoordinateSpace::Local);
+		Tile.EndTangent = SplineEndTangent.GetSafeNormal() * FMath::Min(SplineEndTangent.Size(), CurrentTileLength);
+		Tile.EndLocation = SplineComp->GetLocationAtDistanceAlongSpline(NextDistance, ESplineCoordinateSpace::Local);
+
+		// Rolls
+		Tile.StartRoll = UExtraFunctionalityLibrary::SetSplineMeshRelativeRoll(SplineComp, MidPointRotation, CurrentDistance, true);
+		Tile.EndRoll = UExtraFunctionalityLibrary::SetSplineMeshRelativeRoll(SplineComp, MidPointRotation, NextDistance, true);
+	}
+}
+
+TArray<UMaterialInterface*> FExtraSplineMeshBuilder::GetTileMaterials(const FExtraSplineConstructionInfo& ConstructionInfo)
+{
+	return (ConstructionInfo.OptionalMaterials.Num() > 0) ?
+		ConstructionInfo.OptionalMaterials : UExtraFunctionalityLibrary::GetStaticMaterials(ConstructionInfo.SplineMesh);
+}
+
+USplineMeshComponent* FExtraSplineMeshBuilder::CreateTileComponent(USplineComponent* SplineComp, const FExtraSplineConstructionInfo& ConstructionInfo,
+	const TArray<UMaterialInterface*>& Materials, const FExtraSplineMeshTile& Tile)
+{
+	EXTRA_LLM_SCOPE(SplineMeshes);
+	UWorld* const World = SplineComp->GetWorld();
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	// Create component(or reuse a pooled one) and set default values for it
+	UExtraSplineMeshPoolSubsystem* const Pool = ConstructionInfo.bUseComponentPool ? World->GetSubsystem<UExtraSplineMeshPoolSubsystem>() : nullptr;
+	USplineMeshComponent* MeshComp = Pool ? Pool->AcquireSplineMesh(SplineComp) : NewObject<USplineMeshComponent>(SplineComp);
+	MeshComp->SetMobility(ConstructionInfo.Mobility);
+	if (MeshComp->GetAttachParent() != SplineComp)
+	{
+		MeshComp->SetupAttachment(SplineComp);
+	}
+	MeshComp->SetRelativeTransform(FTransform());
+	MeshComp->SetStartScale(ConstructionInfo.StartScale, false);
+	MeshComp->SetEndScale(ConstructionInfo.EndScale, false);
+	// Grouped collision bodies take over collision and navigation from the tiles
+	const bool bTileCollision = (ConstructionInfo.TilesPerCollisionBody <= 0);
+	MeshComp->SetCanEverAffectNavigation(bTileCollision && ConstructionInfo.bAffectNavigation);
+	MeshComp->SetGenerateOverlapEvents(bTileCollision && ConstructionInfo.bGenerateOverlapEvents);
+	MeshComp->SetCollisionObjectType(UEngineTypes::ConvertToCollisionChannel(ConstructionInfo.ObjectType));
+	MeshComp->SetCollisionEnabled(bTileCollision ? ConstructionInfo.CollisionEnabled.GetValue() : ECollisionEnabled::NoCollision);
+	MeshComp->SetCullDistance(ConstructionInfo.CullDistance);
+	MeshComp->SetCastShadow(ConstructionInfo.bCastShadow);
+	MeshComp->SetForwardAxis(ConstructionInfo.ForwardAxis, false);
+	MeshComp->SetStaticMesh(ConstructionInfo.SplineMesh);
+
+	for (int MatIndex = Materials.Num(); MatIndex-- > 0;)
+	{
+		// Valid check
+		if (Materials[MatIndex])
+		{
+			MeshComp->SetMaterial(MatIndex, Materials[MatIndex]);
+		}
+	}
+
+	MeshComp->SetSplineUpDir(Tile.UpDir, false);
+	MeshComp->SetStartAndEnd(Tile.StartLocation, Tile.StartTangent, Tile.EndLocation, Tile.EndTangent, false);
+	MeshComp->SetStartRoll(Tile.StartRoll, false);
+	MeshComp->SetEndRoll(Tile.EndRoll, false);
+
+	MeshComp->UpdateMesh();
+	MeshComp->RegisterComponentWithWorld(World);
+	return MeshComp;
+}
+
+TArray<UBoxComponent*> FExtraSplineMeshBuilder::CreateCollisionBodies(USplineComponent* SplineComp, const FExtraSplineConstructionInfo& ConstructionInfo,
+	TArrayView<const FExtraSplineMeshTile> Tiles)
+{
+	TArray<UBoxComponent*> Bodies;
+	UWorld* const World = SplineComp ? SplineComp->GetWorld() : nullptr;
+	if (!World || !ConstructionInfo.SplineMesh || ConstructionInfo.TilesPerCollisionBody <= 0 || ConstructionInfo.CollisionEnabled == ECollisionEnabled::NoCollision)
+	{
+		return Bodies;
+	}
+
+	// The mesh's cross section in the spline mesh's right/up frame, with the mesh axes mapped the same way CalcSliceTransform does
+	const FBox MeshBox = ConstructionInfo.SplineMesh->GetBoundingBox();
+	int32 RightAxis = 1;
+	int32 UpAxis = 2;
+	if (ConstructionInfo.ForwardAxis == ESplineMeshAxis::Y)
+	{
+		RightAxis = 2;
+		UpAxis = 0;
+	}
+	else if (ConstructionInfo.ForwardAxis == ESplineMeshAxis::Z)
+	{
+		RightAxis = 0;
+		UpAxis = 1;
+	}
+	const FVector2D MaxScale(FMath::Max(ConstructionInfo.StartScale.X, ConstructionInfo.EndScale.X), FMath::Max(ConstructionInfo.StartScale.Y, ConstructionInfo.EndScale.Y));
+	const FVector2D CrossMin(MeshBox.Min[RightAxis] * MaxScale.X, MeshBox.Min[UpAxis] * MaxScale.Y);
+	const FVector2D CrossMax(MeshBox.Max[RightAxis] * MaxScale.X, MeshBox.Max[UpAxis] * MaxScale.Y);
+
+	Bodies.Reserve(FMath::DivideAndRoundUp(Tiles.Num(), ConstructionInfo.TilesPerCollisionBody));
+	for (int32 FirstTile = 0; FirstTile < Tiles.Num(); FirstTile += ConstructionInfo.TilesPerCollisionBody)
+	{
+		const int32 LastTile = FMath::Min(FirstTile + ConstructionInfo.TilesPerCollisionBody, Tiles.Num()) - 1;
+		const FVector Start = Tiles[FirstTile].StartLocation;
+		const FVector End = Tiles[LastTile].EndLocation;
+
+		// Box runs along the chord of the group, up is taken from the middle tile
+		const FVector Forward = (End - Start).GetSafeNormal();
+		if (Forward.IsNearlyZero())
+		{
+			continue;
+		}
+		const FExtraSplineMeshTile& MiddleTile = Tiles[(FirstTile + LastTile) / 2];
+		const FMatrix BaseFrame = FRotationMatrix::MakeFromXZ(Forward, MiddleTile.UpDir);
+		const FVector BaseRight = BaseFrame.GetScaledAxis(EAxis::Y);
+		const FVector BaseUp = BaseFrame.GetScaledAxis(EAxis::Z);
+
+		// Roll the box like the middle tile, the same way CalcSliceTransform rolls a slice
+		const float BoxRoll = (MiddleTile.StartRoll + MiddleTile.EndRoll) * 0.5f;
+		const FVector Right = (FMath::Cos(BoxRoll) * BaseRight) - (FMath::Sin(BoxRoll) * BaseUp);
+		const FVector Up = (FMath::Cos(BoxRoll) * BaseUp) + (FMath::Sin(BoxRoll) * BaseRight);
+		const FMatrix Frame(Forward, Right, Up, FVector::ZeroVector);
+
+		// Grow the cross section by how far the spline bends away from the chord, and by how much each tile is rolled away from the box
+		FBox Bounds(ForceInit);
+		const auto AddToBounds = [&](const FVector& Location, float Roll)
+		{
+			const FVector Offset = Location - Start;
+			const float CosAng = FMath::Cos(Roll - BoxRoll);
+			const float SinAng = FMath::Sin(Roll - BoxRoll);
+			for (int32 Corner = 0; Corner < 4; Corner++)
+			{
+				const FVector2D Point((Corner & 1) ? CrossMax.X : CrossMin.X, (Corner & 2) ? CrossMax.Y : CrossMin.Y);
+				Bounds += FVector(Offset | Forward, (Offset | Right) + (CosAng * Point.X) + (SinAng * Point.Y), (Offset | Up) + (CosAng * Point.Y) - (SinAng * Point.X));
+			}
+		};
+		for (int32 index = FirstTile; index <= LastTile; index++)
+		{
+			AddToBounds(Tiles[index].StartLocation, Tiles[index].StartRoll);
+			AddToBounds(Tiles[index].EndLocation, Tiles[index].EndRoll);
+		}
+
+		const FVector LocalCenter = Bounds.GetCenter();
+		const FVector Center = Start + (Forward * LocalCenter.X) + (Right * LocalCenter.Y) + (Up * LocalCenter.Z);
+
+		UBoxComponent* const Body = NewObject<UBoxComponent>(SplineComp);
+		Body->SetMobility(ConstructionInfo.Mobility);
+		Body->SetupAttachment(SplineComp);
+		Body->SetRelativeTransform(FTransform(Frame.ToQuat(), Center));
+		Body->SetBoxExtent(Bounds.GetExtent(), false);
+		Body->SetCanEverAffectNavigation(ConstructionInfo.bAffectNavigation);
+		Body->SetGenerateOverlapEvents(ConstructionInfo.bGenerateOverlapEvents);
+		Body->SetCollisionObjectType(UEngineTypes::ConvertToCollisionChannel(ConstructionInfo.ObjectType));
+		Body->SetCollisionEnabled(ConstructionInfo.CollisionEnabled);
+		Body->ComponentTags.Add(CollisionBodyTag);
+		Body->RegisterComponentWithWorld(World);
+		Bodies.Add(Body);
+	}
+
+	UE_LOG(LogExtraSplineMeshBuilder, Verbose, TEXT("Made %d collision bodies for %d tiles along %s"), Bodies.Num(), Tiles.Num(), *GetNameSafe(SplineComp));
+	return Bodies;
+}
+
+FTransform FExtraSplineMeshBuilder::CalcSliceTransform(const FExtraSplineMeshTile& Tile, const FExtraSplineConstructionInfo& ConstructionInfo, float Alpha)
+{
+	// Same math as USplineMeshComponent::CalcSliceTransformAtSplineOffset, without offsets or smooth interpolation since the builder never sets them
+	const FVector SplinePos = FMath::CubicInterp(Tile.StartLocation, Tile.StartTangent, Tile.EndLocation, Tile.EndTangent, Alpha);
+	const FVector SplineDir = FMath::CubicInterpDerivative(Tile.StartLocation, Tile.StartTangent, Tile.EndLocation, Tile.EndTangent, Alpha).GetSafeNormal();
+
+	// Base frenet frame
+	const FVector BaseXVec = (Tile.UpDir ^ SplineDir).GetSafeNormal();
+	const FVector BaseYVec = (SplineDir ^ BaseXVec).GetSafeNormal();
+
+	// Roll the frame around the spline
+	const float UseRoll = FMath::Lerp(Tile.StartRoll, Tile.EndRoll, Alpha);
+	const float CosAng = FMath::Cos(UseRoll);
+	const float SinAng = FMath::Sin(UseRoll);
+	const FVector XVec = (CosAng * BaseXVec) - (SinAng * BaseYVec);
+	const FVector YVec = (CosAng * BaseYVec) + (SinAng * BaseXVec);
+
+	const FVector2D UseScale = FMath::Lerp(ConstructionInfo.StartScale, ConstructionInfo.EndScale, Alpha);
+
+	FTransform SliceTransform;
+	switch (ConstructionInfo.ForwardAxis)
+	{
+	case ESplineMeshAxis::Y:
+		SliceTransform = FTransform(YVec, SplineDir, XVec, SplinePos);
+		SliceTransform.SetScale3D(FVector(UseScale.Y, 1.0f, UseScale.X));
+		break;
+	case ESplineMeshAxis::Z:
+		SliceTransform = FTransform(XVec, YVec, SplineDir, SplinePos);
+		SliceTransform.SetScale3D(FVector(UseScale.X, UseScale.Y, 1.0f));
+		break;
+	default:
+		SliceTransform = FTransform(SplineDir, XVec, YVec, SplinePos);
+		SliceTransform.SetScale3D(FVector(1.0f, UseScale.X, UseScale.Y));
+		break;
+	}
+	return SliceTransform;
+}
+
+void FExtraSplineMeshBuilder::DrawTilesDebug(const USplineComponent* SplineComp, const FExtraSplineConstructionInfo& ConstructionInfo, TArrayView<const FExtraSplineMeshTile> Tiles)
+{
+	UExtraDebugDrawSubsystem* const DebugDraw = ConstructionInfo.bDebugMode ? UExtraDebugDrawSubsystem::Get(SplineComp) : nullptr;
+	if (!DebugDraw)
+	{
+		return;
+	}
+
+	TArray<FTransform> TileTransforms;
+	TileTransforms.Reserve(Tiles.Num());
+	for (const FExtraSplineMeshTile& Tile : Tiles)
+	{
+		TileTransforms.Emplace(SplineComp->GetQuaternionAtDistanceAlongSpline(Tile.MidPointDistance, ESplineCoordinateSpace::World),
+			SplineComp->GetLocationAtDistanceAlongSpline(Tile.MidPointDistance, ESplineCoordinateSpace::World));
+	}
+
+	FExtraDebugArrowSettings Settings;
+	Settings.ArrowLength = ConstructionInfo.ArrowLength;
+	Settings.ArrowSize = ConstructionInfo.ArrowSize;
+	Settings.ArrowThickness = ConstructionInfo.ArrowThickness;
+	// A debug time of 0 or less means a single frame for the builders, not forever like it does for the debug draw layer
+	Settings.Duration = FMath::Max(ConstructionInfo.DebugTime, KINDA_SMALL_NUMBER);
+
+	// Each build replaces the spline's previous arrows, so construction script rebuilds don't pile them up
+	const int32 Handle = DebugDraw->DrawCoordinateArrowsAtTransforms(TileTransforms, Settings, DebugDraw->GetObjectHandle(SplineComp));
+	DebugDraw->SetObjectHandle(SplineComp, Handle);
+}
+
+UExtraBuildSplineMeshesAction::UExtraBuildSplineMeshesAction()
+{
+	NextTile = 0;
+	MillisecondsPerFrame = 2.0f;
+	bIsBuilding = false;
+}
+
+UExtraBuildSplineMeshesAction* UExtraBuildSplineMeshesAction::BuildSplineMeshesAlongSplineAsync(UObject* WorldContextObject, USplineComponent* SplineComp,
+	FExtraSplineConstructionInfo ConstructionInfo, float MillisecondsPerFrame)
+{
+	UExtraBuildSplineMeshesAction* const Action = NewObject<UExtraBuildSplineMeshesAction>();
+	Action->Spline = SplineComp;
+	Action->ConstructionInfo = ConstructionInfo;
+	Action->MillisecondsPerFrame = FMath::Max(MillisecondsPerFrame, 0.0f);
+	Action->RegisterWithGameInstance(WorldContextObject);
+	return Action;
+}
+
+void UExtraBuildSplineMeshesAction::Activate()
+{
+	EXTRA_LLM_SCOPE(SplineMeshes);
+	USplineComponent* const SplineComp = Spline.Get();
+	if (!SplineComp || !ConstructionInfo.SplineMesh || !SplineComp->GetWorld())
+	{
+		UE_LOG(LogExtraSplineMeshBuilder, Warning, TEXT("BuildSplineMeshesAlongSplineAsync: Needs a valid spline in a world and a spline mesh."));
+		Finish(false);
+		return;
+	}
+
+	// All the spline evaluation happens up front, only component creation is spread across frames
+	FExtraSplineMeshBuilder::ComputeTiles(SplineComp, ConstructionInfo, Tiles);
+	Materials = FExtraSplineMeshBuilder::GetTileMaterials(ConstructionInfo);
+	FExtraSplineMeshBuilder::DrawTilesDebug(SplineComp, ConstructionInfo, Tiles);
+	SplineMeshes.Reserve(Tiles.Num());
+	NextTile = 0;
+	bIsBuilding = true;
+
+	UE_LOG(LogExtraSplineMeshBuilder, Verbose, TEXT("Building %d spline mesh tiles along %s over multiple frames"), Tiles.Num(), *GetNameSafe(SplineComp));
+}
+
+void UExtraBuildSplineMeshesAction::Tick(float DeltaTime)
+{
+	USplineComponent* const SplineComp = Spline.Get();
+	if (!SplineComp || !SplineComp->GetWorld())
+	{
+		Finish(false);
+		return;
+	}
+
+	const double EndTime = FPlatformTime::Seconds() + (MillisecondsPerFrame / 1000.0);
+	do
+	{
+		if (NextTile >= Tiles.Num())
+		{
+			break;
+		}
+
+		const FExtraSplineMeshTile& Tile = Tiles[NextTile++];
+		if (USplineMeshComponent* const MeshComp = FExtraSplineMeshBuilder::CreateTileComponent(SplineComp, ConstructionInfo, Materials, Tile))
+		{
+			SplineMeshes.Add(MeshComp);
+		}
+	}
+	while (FPlatformTime::Seconds() < EndTime);
+
+	if (NextTile >= Tiles.Num())
+	{
+		Finish(true);
+	}
+	else
+	{
+		OnProgress.Broadcast(GetProgress(), SplineMeshes);
+	}
+}
+
+void UExtraBuildSplineMeshesAction::Cancel()
+{
+	if (bIsBuilding)
+	{
+		Finish(false);
+	}
+}
+
+TStatId UExtraBuildSplineMeshesAction::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UExtraBuildSplineMeshesAction, STATGROUP_Tickables);
+}
+
+void UExtraBuildSplineMeshesAction::Finish(bool bSuccess)
+{
+	const float Progress = GetProgress();
+	bIsBuilding = false;
+	if (bSuccess)
+	{
+		FExtraSplineMeshBuilder::CreateCollisionBodies(Spline.Get(), ConstructionInfo, Tiles);
+	}
+	Tiles.Empty();
+
+	if (bSuccess)
+	{
+		OnCompleted.Broadcast(1.0f, SplineMeshes);
+	}
+	else
+	{
+		OnFailed.Broadcast(Progress, SplineMeshes);
+	}
+	SetReadyToDestroy();
+}
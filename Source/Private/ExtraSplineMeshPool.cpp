@@ -0,0 +1,313 @@
+#include "ExtraSplineMeshPool.h"
+#include "Components/SplineComponent.h"
+#include "Components/SplineMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "ExtraMemoryTracking.h"
+#include "GameFramework/Actor.h"
+#include "UObject/Package.h"
+
+DEFINE_LOG_CATEGORY(LogExtraSplineMeshPool);
+
+UExtraSplineMeshPoolSubsystem::UExtraSplineMeshPoolSubsystem()
+{
+	MaxPooledComponents = 512;
+	bPerSplinePools = true;
+	NumPooled = 0;
+}
+
+void UExtraSplineMeshPoolSubsystem::Deinitialize()
+{
+	EmptyPool();
+	PoolCreatedComponents.Empty();
+
+	Super::Deinitialize();
+}
+
+void UExtraSplineMeshPoolSubsystem::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	UExtraSplineMeshPoolSubsystem* const This = CastChecked<UExtraSplineMeshPoolSubsystem>(InThis);
+	Collector.AddReferencedObjects(This->WorldPool, This);
+	for (TPair<TWeakObjectPtr<USplineComponent>, TArray<USplineMeshComponent*>>& Pair : This->SplinePools)
+	{
+		Collector.AddReferencedObjects(Pair.Value, This);
+	}
+
+	Super::AddReferencedObjects(InThis, Collector);
+}
+
+UExtraSplineMeshPoolSubsystem* UExtraSplineMeshPoolSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (const UWorld* const World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull))
+	{
+		return World->GetSubsystem<UExtraSplineMeshPoolSubsystem>();
+	}
+	return nullptr;
+}
+
+USplineMeshComponent* UExtraSplineMeshPoolSubsystem::AcquireSplineMesh(USplineComponent* SplineComp)
+{
+	EXTRA_LLM_SCOPE(SplineMeshes);
+	if (!SplineComp)
+	{
+		return nullptr;
+	}
+
+	USplineMeshComponent* SplineMesh = TakePooledComponent(SplineComp);
+	if (SplineMesh)
+	{
+		Stats.NumHits++;
+
+		// Components from the world pool or another spline have to be moved over so the right actor owns them
+		if (SplineMesh->GetOuter() != SplineComp)
+		{
+			SplineMesh->Rename(nullptr, SplineComp, REN_DontCreateRedirectors | REN_ForceNoResetLoaders);
+		}
+	}
+	else
+	{
+		Stats.NumMisses++;
+		SplineMesh = NewObject<USplineMeshComponent>(SplineComp);
+		PoolCreatedComponents.Add(SplineMesh);
+	}
+
+	SplineMesh->SetupAttachment(SplineComp);
+	BindToOwnerDestroyed(SplineComp);
+	return SplineMesh;
+}
+
+void UExtraSplineMeshPoolSubsystem::ReleaseSplineMesh(USplineMeshComponent* SplineMesh)
+{
+	PoolComponent(SplineMesh, bPerSplinePools);
+}
+
+void UExtraSplineMeshPoolSubsystem::PoolComponent(USplineMeshComponent* SplineMesh, bool bKeepWithSpline)
+{
+	if (!SplineMesh || SplineMesh->IsPendingKill() || PooledComponents.Contains(SplineMesh))
+	{
+		return;
+	}
+
+	Stats.NumReleased++;
+	if (NumPooled >= MaxPooledComponents)
+	{
+		Stats.NumDestroyedOverCap++;
+		PoolCreatedComponents.Remove(SplineMesh);
+		SplineMesh->DestroyComponent();
+		return;
+	}
+
+	USplineComponent* const SplineComp = Cast<USplineComponent>(SplineMesh->GetOuter());
+	ResetComponent(SplineMesh);
+	PoolCreatedComponents.Add(SplineMesh);
+
+	if (bKeepWithSpline && SplineComp && !SplineComp->IsPendingKill())
+	{
+		SplinePools.FindOrAdd(SplineComp).Add(SplineMesh);
+	}
+	else
+	{
+		// Nothing owns world pool components until they're acquired again
+		SplineMesh->Rename(nullptr, GetTransientPackage(), REN_DontCreateRedirectors | REN_ForceNoResetLoaders);
+		WorldPool.Add(SplineMesh);
+	}
+	PooledComponents.Add(SplineMesh);
+	NumPooled++;
+}
+
+void UExtraSplineMeshPoolSubsystem::ReleaseSplineMeshes(const TArray<USplineMeshComponent*>& SplineMeshes)
+{
+	PruneSplinePools();
+	for (USplineMeshComponent* const SplineMesh : SplineMeshes)
+	{
+		ReleaseSplineMesh(SplineMesh);
+	}
+}
+
+void UExtraSplineMeshPoolSubsystem::Prewarm(int32 Count, USplineComponent* SplineComp)
+{
+	EXTRA_LLM_SCOPE(SplineMeshes);
+	const int32 NumToCreate = FMath::Min(Count, MaxPooledComponents - NumPooled);
+	if (NumToCreate <= 0)
+	{
+		return;
+	}
+
+	TArray<USplineMeshComponent*>& Pool = (bPerSplinePools && SplineComp) ? SplinePools.FindOrAdd(SplineComp) : WorldPool;
+	UObject* const Outer = (bPerSplinePools && SplineComp) ? (UObject*)SplineComp : (UObject*)GetTransientPackage();
+
+	Pool.Reserve(Pool.Num() + NumToCreate);
+	for (int32 index = 0; index < NumToCreate; index++)
+	{
+		USplineMeshComponent* const SplineMesh = NewObject<USplineMeshComponent>(Outer);
+		PoolCreatedComponents.Add(SplineMesh);
+		PooledComponents.Add(SplineMesh);
+		Pool.Add(SplineMesh);
+	}
+	NumPooled += NumToCreate;
+
+	if (SplineComp)
+	{
+		BindToOwnerDestroyed(SplineComp);
+	}
+}
+
+void UExtraSplineMeshPoolSubsystem::EmptyPool()
+{
+	for (USplineMeshComponent* const SplineMesh : WorldPool)
+	{
+		if (SplineMesh && !SplineMesh->IsPendingKill())
+		{
+			SplineMesh->DestroyComponent();
+		}
+	}
+	for (TPair<TWeakObjectPtr<USplineComponent>, TArray<USplineMeshComponent*>>& Pair : SplinePools)
+	{
+		for (USplineMeshComponent* const SplineMesh : Pair.Value)
+		{
+			if (SplineMesh && !SplineMesh->IsPendingKill())
+			{
+				SplineMesh->DestroyComponent();
+			}
+		}
+	}
+	WorldPool.Empty();
+	SplinePools.Empty();
+	PooledComponents.Empty();
+	NumPooled = 0;
+}
+
+FExtraComponentPoolStats UExtraSplineMeshPoolSubsystem::GetStats() const
+{
+	FExtraComponentPoolStats Result = Stats;
+	Result.NumPooled = NumPooled;
+	return Result;
+}
+
+USplineMeshComponent* UExtraSplineMeshPoolSubsystem::TakePooledComponent(USplineComponent* SplineComp)
+{
+	if (TArray<USplineMeshComponent*>* const SplinePool = SplinePools.Find(SplineComp))
+	{
+		if (USplineMeshComponent* const SplineMesh = PopPooledComponent(*SplinePool))
+		{
+			return SplineMesh;
+		}
+	}
+
+	if (USplineMeshComponent* const SplineMesh = PopPooledComponent(WorldPool))
+	{
+		return SplineMesh;
+	}
+
+	// Splines that were destroyed still have pooled components sitting around
+	PruneSplinePools();
+	return PopPooledComponent(WorldPool);
+}
+
+USplineMeshComponent* UExtraSplineMeshPoolSubsystem::PopPooledComponent(TArray<USplineMeshComponent*>& Pool)
+{
+	while (Pool.Num() > 0)
+	{
+		NumPooled--;
+		USplineMeshComponent* const SplineMesh = Pool.Pop(false);
+		PooledComponents.Remove(SplineMesh);
+		if (SplineMesh && !SplineMesh->IsPendingKill())
+		{
+			return SplineMesh;
+		}
+	}
+	return nullptr;
+}
+
+void UExtraSplineMeshPoolSubsystem::ResetComponent(USplineMeshComponent* SplineMesh) const
+{
+	if (SplineMesh->IsRegistered())
+	{
+		SplineMesh->UnregisterComponent();
+	}
+	SplineMesh->DetachFromComponent(FDetachmentTransformRules::KeepRelativeTransform);
+	SplineMesh->SetRelativeTransform(FTransform::Identity);
+
+	// The next user sets everything it needs, this just stops old settings from leaking through
+	SplineMesh->EmptyOverrideMaterials();
+	SplineMesh->SplineParams = FSplineMeshParams();
+	SplineMesh->SplineUpDir = FVector::UpVector;
+	SplineMesh->ComponentTags.Reset();
+}
+
+void UExtraSplineMeshPoolSubsystem::BindToOwnerDestroyed(USplineComponent* SplineComp)
+{
+	if (AActor* const Owner = SplineComp->GetOwner())
+	{
+		Owner->OnDestroyed.AddUniqueDynamic(this, &UExtraSplineMeshPoolSubsystem::OnSplineOwnerDestroyed);
+	}
+}
+
+void UExtraSplineMeshPoolSubsystem::PruneSplinePools()
+{
+	for (auto It = SplinePools.CreateIterator(); It; ++It)
+	{
+		if (It.Key().IsValid() && !It.Key()->IsPendingKill())
+		{
+			continue;
+		}
+
+		for (USplineMeshComponent* const SplineMesh : It.Value())
+		{
+			if (SplineMesh && !SplineMesh->IsPendingKill())
+			{
+				SplineMesh->Rename(nullptr, GetTransientPackage(), REN_DontCreateRedirectors | REN_ForceNoResetLoaders);
+				WorldPool.Add(SplineMesh);
+			}
+			else
+			{
+				PooledComponents.Remove(SplineMesh);
+				NumPooled--;
+			}
+		}
+		It.RemoveCurrent();
+	}
+}
+
+void UExtraSplineMeshPoolSubsystem::OnSplineOwnerDestroyed(AActor* DestroyedActor)
+{
+	if (!DestroyedActor)
+	{
+		return;
+	}
+
+	// Take back our components before the actor destroys them, straight into the world pool since the actor's splines are going away too.
+	// Ones already in the actor's spline pools are moved over below
+	TInlineComponentArray<USplineMeshComponent*> SplineMeshes(DestroyedActor);
+	for (USplineMeshComponent* const SplineMesh : SplineMeshes)
+	{
+		if (PoolCreatedComponents.Contains(SplineMesh) && !PooledComponents.Contains(SplineMesh))
+		{
+			PoolComponent(SplineMesh, false);
+		}
+	}
+
+	// The spline pools of the actor's splines still hold components that are owned by them
+	for (auto It = SplinePools.CreateIterator(); It; ++It)
+	{
+		if (It.Key().IsValid() && It.Key()->GetOwner() != DestroyedActor)
+		{
+			continue;
+		}
+
+		for (USplineMeshComponent* const SplineMesh : It.Value())
+		{
+			if (SplineMesh && !SplineMesh->IsPendingKill())
+			{
+				SplineMesh->Rename(nullptr, GetTransientPackage(), REN_DontCreateRedirectors | REN_ForceNoResetLoaders);
+				WorldPool.Add(SplineMesh);
+			}
+			else
+			{
+				PooledComponents.Remove(SplineMesh);
+				NumPooled--;
+			}
+		}
+		It.RemoveCurrent();
+	}
+}
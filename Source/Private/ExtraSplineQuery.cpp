@@ -0,0 +1,383 @@
+#include "ExtraSplineQuery.h"
+#include "Algo/BinarySearch.h"
+#include "Async/ParallelFor.h"
+#include "ExtraFunctionalityLibrary.h"
+#include "ExtraMemoryTracking.h"
+#include "ExtraPlatformProfile.h"
+
+DEFINE_LOG_CATEGORY(LogExtraSplineQuery);
+
+namespace ExtraSplineQuery
+{
+	/** Samples taken on a piece to pick the starting point for the Newton iterations */
+	static const int32 SeedSamplesPerPiece = 4;
+	/** Locations past which a batch query is spread across multiple threads */
+	static const int32 MinLocationsForParallel = 64;
+	/** Fewest locations per worker task, the actual batch size grows with the number of locations */
+	static const int32 MinLocationsPerBatch = 32;
+}
+
+UExtraSplineQuery::UExtraSplineQuery()
+{
+	RootNode = INDEX_NONE;
+	SubdivisionsPerSegment = 4;
+	NewtonIterations = 4;
+
+	BuiltSplineHash = 0;
+	LastCheckedFrame = 0;
+}
+
+UExtraSplineQuery* UExtraSplineQuery::CreateSplineQuery(USplineComponent* InSpline, int32 SubdivisionsPerSegment, int32 NewtonIterations)
+{
+	if (!InSpline)
+	{
+		return nullptr;
+	}
+
+	UExtraSplineQuery* const Query = NewObject<UExtraSplineQuery>(InSpline);
+	Query->Spline = InSpline;
+	Query->SubdivisionsPerSegment = FMath::Max(SubdivisionsPerSegment, 1);
+	Query->NewtonIterations = FMath::Max(NewtonIterations, 0);
+	Query->Rebuild();
+	return Query;
+}
+
+void UExtraSplineQuery::Rebuild()
+{
+	EXTRA_LLM_SCOPE(Splines);
+	LastCheckedFrame = GFrameCounter;
+
+	Pieces.Reset();
+	Nodes.Reset();
+	RootNode = INDEX_NONE;
+	ReparamKeys.Reset();
+	ReparamDistances.Reset();
+
+	const USplineComponent* const SplineComp = Spline.Get();
+	if (!SplineComp || SplineComp->SplineCurves.Position.Points.Num() == 0)
+	{
+		BuiltSplineHash = 0;
+		return;
+	}
+
+	BuiltSplineHash = UExtraFunctionalityLibrary::GetSplineCurvesHash(SplineComp);
+
+	const FInterpCurveVector& Position = SplineComp->SplineCurves.Position;
+	const int32 NumPoints = Position.Points.Num();
+	const int32 NumSegments = Position.bIsLooped ? NumPoints : (NumPoints - 1);
+	const float PieceRange = 1.0f / SubdivisionsPerSegment;
+
+	TArray<FBox> PieceBounds;
+	Pieces.Reserve(FMath::Max(NumSegments * SubdivisionsPerSegment, 1));
+	PieceBounds.Reserve(FMath::Max(NumSegments * SubdivisionsPerSegment, 1));
+
+	for (int32 SegmentIndex = 0; SegmentIndex < NumSegments; SegmentIndex++)
+	{
+		const bool bClosingSegment = (SegmentIndex == NumPoints - 1);
+		const FInterpCurvePoint<FVector>& Start = Position.Points[SegmentIndex];
+		const FInterpCurvePoint<FVector>& End = Position.Points[bClosingSegment ? 0 : (SegmentIndex + 1)];
+		// Same key width FInterpCurve::Eval uses, which the tangents are scaled by
+		const float KeyWidth = bClosingSegment ? Position.LoopKeyOffset : (End.InVal - Start.InVal);
+
+		// The segment as a hermite curve, then as a cubic in 0-1
+		FVector EndLocation = End.OutVal;
+		FVector StartTangent = Start.LeaveTangent * KeyWidth;
+		FVector EndTangent = End.ArriveTangent * KeyWidth;
+		if (Start.InterpMode == CIM_Linear)
+		{
+			StartTangent = EndTangent = (End.OutVal - Start.OutVal);
+		}
+		else if (Start.InterpMode == CIM_Constant)
+		{
+			EndLocation = Start.OutVal;
+			StartTangent = EndTangent = FVector::ZeroVector;
+		}
+		const FVector A = (2.0f * Start.OutVal) + StartTangent - (2.0f * EndLocation) + EndTangent;
+		const FVector B = (-3.0f * Start.OutVal) - (2.0f * StartTangent) + (3.0f * EndLocation) - EndTangent;
+		const FVector C = StartTangent;
+		const FVector D = Start.OutVal;
+
+		for (int32 SubIndex = 0; SubIndex < SubdivisionsPerSegment; SubIndex++)
+		{
+			// Reparameterize the segment's cubic to just this piece
+			const float U = SubIndex * PieceRange;
+			FPiece& Piece = Pieces.AddDefaulted_GetRef();
+			Piece.A = A * (PieceRange * PieceRange * PieceRange);
+			Piece.B = ((3.0f * A * U) + B) * (PieceRange * PieceRange);
+			Piece.C = ((((3.0f * A * U) + (2.0f * B)) * U) + C) * PieceRange;
+			Piece.D = ((((A * U) + B) * U) + C) * U + D;
+			Piece.StartKey = Start.InVal + (U * KeyWidth);
+			Piece.KeyRange = PieceRange * KeyWidth;
+
+			// A cubic always stays inside the hull of its bezier control points
+			FBox& Bounds = PieceBounds.Add_GetRef(FBox(ForceInit));
+			Bounds += Piece.D;
+			Bounds += Piece.D + (Piece.C / 3.0f);
+			Bounds += Piece.D + (((2.0f * Piece.C) + Piece.B) / 3.0f);
+			Bounds += Piece.Eval(1.0f);
+		}
+	}
+
+	// A single point spline is just that point
+	if (Pieces.Num() == 0)
+	{
+		FPiece& Piece = Pieces.AddZeroed_GetRef();
+		Piece.D = Position.Points[0].OutVal;
+		Piece.StartKey = Position.Points[0].InVal;
+		PieceBounds.Add(FBox(Piece.D, Piece.D));
+	}
+
+	TArray<int32> PieceIndices;
+	PieceIndices.SetNumUninitialized(Pieces.Num());
+	for (int32 index = 0; index < Pieces.Num(); index++)
+	{
+		PieceIndices[index] = index;
+	}
+	Nodes.Reserve((Pieces.Num() * 2) - 1);
+	RootNode = BuildNode(PieceIndices, PieceBounds, 0, PieceIndices.Num());
+
+	const FInterpCurveFloat& ReparamTable = SplineComp->SplineCurves.ReparamTable;
+	ReparamKeys.Reserve(ReparamTable.Points.Num());
+	ReparamDistances.Reserve(ReparamTable.Points.Num());
+	for (const FInterpCurvePoint<float>& Point : ReparamTable.Points)
+	{
+		ReparamKeys.Add(Point.OutVal);
+		ReparamDistances.Add(Point.InVal);
+	}
+
+	UE_LOG(LogExtraSplineQuery, Verbose, TEXT("Built closest point query for %s with %d pieces"), *GetNameSafe(SplineComp), Pieces.Num());
+}
+
+void UExtraSplineQuery::ConditionalRebuild(bool bForceCheck)
+{
+	if (!bForceCheck && LastCheckedFrame == GFrameCounter)
+	{
+		return;
+	}
+	LastCheckedFrame = GFrameCounter;
+
+	if (const USplineComponent* const SplineComp = Spline.Get())
+	{
+		if (UExtraFunctionalityLibrary::GetSplineCurvesHash(SplineComp) != BuiltSplineHash)
+		{
+			Rebuild();
+		}
+	}
+}
+
+float UExtraSplineQuery::FindInputKeyClosestToWorldLocation(const FVector& WorldLocation)
+{
+	ConditionalRebuild();
+	if (!IsValidQuery())
+	{
+		return 0.0f;
+	}
+	return FindClosestInputKeyLocal(Spline->GetComponentTransform().InverseTransformPosition(WorldLocation));
+}
+
+bool UExtraSplineQuery::FindClosestToWorldLocation(const FVector& WorldLocation, float& OutInputKey, float& OutDistance, FTransform& OutTransform, bool bUseScale)
+{
+	ConditionalRebuild();
+	if (!IsValidQuery())
+	{
+		OutInputKey = 0.0f;
+		OutDistance = 0.0f;
+		OutTransform = FTransform::Identity;
+		return false;
+	}
+
+	const USplineComponent* const SplineComp = Spline.Get();
+	OutInputKey = FindClosestInputKeyLocal(SplineComp->GetComponentTransform().InverseTransformPosition(WorldLocation));
+	OutDistance = DistanceAtInputKey(OutInputKey);
+	OutTransform = SplineComp->GetTransformAtSplineInputKey(OutInputKey, ESplineCoordinateSpace::World, bUseScale);
+	return true;
+}
+
+bool UExtraSplineQuery::FindClosestToWorldLocations(const TArray<FVector>& WorldLocations, TArray<float>& OutInputKeys, TArray<float>& OutDistances,
+	TArray<FTransform>& OutTransforms, bool bUseScale)
+{
+	EXTRA_LLM_SCOPE(Splines);
+	ConditionalRebuild();
+	const bool bValid = IsValidQuery();
+	const int32 NumLocations = bValid ? WorldLocations.Num() : 0;
+	OutInputKeys.SetNumUninitialized(NumLocations);
+	OutDistances.SetNumUninitialized(NumLocations);
+	OutTransforms.SetNumUninitialized(NumLocations);
+
+	if (NumLocations == 0)
+	{
+		return bValid;
+	}
+
+	// Only the lookups are spread across threads, the spline itself is only read
+	const USplineComponent* const SplineComp = Spline.Get();
+	const FTransform ComponentTransform = SplineComp->GetComponentTransform();
+
+	const int32 BatchSize = FExtraPlatformProfiler::GetBatchSize(NumLocations, ExtraSplineQuery::MinLocationsPerBatch);
+	const int32 NumBatches = FMath::DivideAndRoundUp(NumLocations, BatchSize);
+	ParallelFor(NumBatches, [&](int32 BatchIndex)
+	{
+		const int32 FirstIndex = BatchIndex * BatchSize;
+		const int32 LastIndex = FMath::Min(FirstIndex + BatchSize, NumLocations);
+		for (int32 index = FirstIndex; index < LastIndex; index++)
+		{
+			const float InKey = FindClosestInputKeyLocal(ComponentTransform.InverseTransformPosition(WorldLocations[index]));
+			OutInputKeys[index] = InKey;
+			OutDistances[index] = DistanceAtInputKey(InKey);
+			OutTransforms[index] = SplineComp->GetTransformAtSplineInputKey(InKey, ESplineCoordinateSpace::Local, bUseScale) * ComponentTransform;
+		}
+	}, FExtraPlatformProfiler::ShouldForceSingleThread(NumLocations, ExtraSplineQuery::MinLocationsForParallel));
+
+	return true;
+}
+
+float UExtraSplineQuery::FindClosestInputKeyLocal(const FVector& LocalLocation) const
+{
+	if (RootNode == INDEX_NONE)
+	{
+		return 0.0f;
+	}
+
+	float BestDistanceSquared = MAX_flt;
+	float BestKey = 0.0f;
+
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Stack.Add(RootNode);
+	while (Stack.Num() > 0)
+	{
+		const FNode& Node = Nodes[Stack.Pop(false)];
+		if (Node.Bounds.ComputeSquaredDistanceToPoint(LocalLocation) >= BestDistanceSquared)
+		{
+			continue;
+		}
+
+		if (Node.Piece != INDEX_NONE)
+		{
+			const FPiece& Piece = Pieces[Node.Piece];
+			float DistanceSquared;
+			const float V = FindClosestOnPiece(Piece, LocalLocation, DistanceSquared);
+			if (DistanceSquared < BestDistanceSquared)
+			{
+				BestDistanceSquared = DistanceSquared;
+				BestKey = Piece.StartKey + (V * Piece.KeyRange);
+			}
+			continue;
+		}
+
+		// Visit the nearer child first so the best distance shrinks sooner and more of the tree gets skipped
+		const float LeftDistanceSquared = Nodes[Node.Left].Bounds.ComputeSquaredDistanceToPoint(LocalLocation);
+		const float RightDistanceSquared = Nodes[Node.Right].Bounds.ComputeSquaredDistanceToPoint(LocalLocation);
+		if (LeftDistanceSquared < RightDistanceSquared)
+		{
+			Stack.Add(Node.Right);
+			Stack.Add(Node.Left);
+		}
+		else
+		{
+			Stack.Add(Node.Left);
+			Stack.Add(Node.Right);
+		}
+	}
+	return BestKey;
+}
+
+float UExtraSplineQuery::DistanceAtInputKey(float InKey) const
+{
+	if (ReparamKeys.Num() == 0)
+	{
+		return 0.0f;
+	}
+
+	const int32 UpperIndex = Algo::UpperBound(ReparamKeys, InKey);
+	if (UpperIndex <= 0)
+	{
+		return ReparamDistances[0];
+	}
+	if (UpperIndex >= ReparamKeys.Num())
+	{
+		return ReparamDistances.Last();
+	}
+
+	const int32 LowerIndex = UpperIndex - 1;
+	const float KeyRange = ReparamKeys[UpperIndex] - ReparamKeys[LowerIndex];
+	const float Alpha = (KeyRange > KINDA_SMALL_NUMBER) ? ((InKey - ReparamKeys[LowerIndex]) / KeyRange) : 0.0f;
+	return FMath::Lerp(ReparamDistances[LowerIndex], ReparamDistances[UpperIndex], Alpha);
+}
+
+int32 UExtraSplineQuery::BuildNode(TArray<int32>& PieceIndices, const TArray<FBox>& PieceBounds, int32 Begin, int32 End)
+{
+	// Nodes can be reallocated by the recursion below, so only index into it
+	const int32 NodeIndex = Nodes.AddDefaulted();
+	Nodes[NodeIndex].Bounds = FBox(ForceInit);
+	Nodes[NodeIndex].Left = INDEX_NONE;
+	Nodes[NodeIndex].Right = INDEX_NONE;
+	Nodes[NodeIndex].Piece = INDEX_NONE;
+
+	FBox CenterBounds(ForceInit);
+	for (int32 index = Begin; index < End; index++)
+	{
+		Nodes[NodeIndex].Bounds += PieceBounds[PieceIndices[index]];
+		CenterBounds += PieceBounds[PieceIndices[index]].GetCenter();
+	}
+
+	if ((End - Begin) == 1)
+	{
+		Nodes[NodeIndex].Piece = PieceIndices[Begin];
+		return NodeIndex;
+	}
+
+	// Split at the median along the axis the pieces are most spread out on
+	const FVector CenterSize = CenterBounds.GetSize();
+	const int32 SplitAxis = (CenterSize.X >= CenterSize.Y && CenterSize.X >= CenterSize.Z) ? 0 : ((CenterSize.Y >= CenterSize.Z) ? 1 : 2);
+	Sort(PieceIndices.GetData() + Begin, End - Begin, [&PieceBounds, SplitAxis](int32 Left, int32 Right)
+	{
+		return PieceBounds[Left].GetCenter()[SplitAxis] < PieceBounds[Right].GetCenter()[SplitAxis];
+	});
+
+	const int32 Middle = (Begin + End) / 2;
+	const int32 LeftNode = BuildNode(PieceIndices, PieceBounds, Begin, Middle);
+	const int32 RightNode = BuildNode(PieceIndices, PieceBounds, Middle, End);
+	Nodes[NodeIndex].Left = LeftNode;
+	Nodes[NodeIndex].Right = RightNode;
+	return NodeIndex;
+}
+
+float UExtraSplineQuery::FindClosestOnPiece(const FPiece& Piece, const FVector& Location, float& OutDistanceSquared) const
+{
+	// Start from the closest of a few samples so Newton doesn't settle on the wrong side of a bend
+	float SeedV = 0.0f;
+	float SeedDistanceSquared = MAX_flt;
+	for (int32 index = 0; index <= ExtraSplineQuery::SeedSamplesPerPiece; index++)
+	{
+		const float V = (float)index / ExtraSplineQuery::SeedSamplesPerPiece;
+		const float DistanceSquared = FVector::DistSquared(Piece.Eval(V), Location);
+		if (DistanceSquared < SeedDistanceSquared)
+		{
+			SeedDistanceSquared = DistanceSquared;
+			SeedV = V;
+		}
+	}
+
+	// Newton's method on the derivative of the squared distance
+	float V = SeedV;
+	for (int32 Iteration = 0; Iteration < NewtonIterations; Iteration++)
+	{
+		const FVector Delta = Piece.Eval(V) - Location;
+		const FVector FirstDerivative = Piece.EvalDerivative(V);
+		const float Numerator = Delta | FirstDerivative;
+		const float Denominator = (FirstDerivative | FirstDerivative) + (Delta | Piece.EvalSecondDerivative(V));
+		if (FMath::Abs(Denominator) < KINDA_SMALL_NUMBER)
+		{
+			break;
+		}
+		V = FMath::Clamp(V - (Numerator / Denominator), 0.0f, 1.0f);
+	}
+
+	OutDistanceSquared = FVector::DistSquared(Piece.Eval(V), Location);
+	if (OutDistanceSquared > SeedDistanceSquared)
+	{
+		OutDistanceSquared = SeedDistanceSquared;
+		return SeedV;
+	}
+	return V;
+}
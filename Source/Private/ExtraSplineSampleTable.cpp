@@ -0,0 +1,383 @@
+#include "ExtraSplineSampleTable.h"
+#include "ExtraFunctionalityLibrary.h"
+#include "ExtraMemoryTracking.h"
+
+DEFINE_LOG_CATEGORY(LogExtraSplineSampleTable);
+
+namespace ExtraSplineSampleTable
+{
+	/** Samples per segment the first build attempt starts with, doubled until the error is small enough */
+	static const int32 MinSamplesPerSegment = 4;
+}
+
+UExtraSplineSampleTable::UExtraSplineSampleTable()
+{
+	KeySpacing = 1.0f;
+	DistanceSpacing = 1.0f;
+	MaxInputKey = 0.0f;
+	SplineLength = 0.0f;
+
+	MaxPositionError = 1.0f;
+	MaxSamplesPerSegment = 256;
+	MeasuredPositionError = 0.0f;
+
+	BuiltSplineHash = 0;
+	LastCheckedFrame = 0;
+}
+
+UExtraSplineSampleTable* UExtraSplineSampleTable::CreateSplineSampleTable(USplineComponent* InSpline, float MaxPositionError, int32 MaxSamplesPerSegment)
+{
+	if (!InSpline)
+	{
+		return nullptr;
+	}
+
+	UExtraSplineSampleTable* const Table = NewObject<UExtraSplineSampleTable>(InSpline);
+	Table->Spline = InSpline;
+	Table->MaxPositionError = FMath::Max(MaxPositionError, KINDA_SMALL_NUMBER);
+	Table->MaxSamplesPerSegment = FMath::Max(MaxSamplesPerSegment, ExtraSplineSampleTable::MinSamplesPerSegment);
+	Table->Rebuild();
+	return Table;
+}
+
+void UExtraSplineSampleTable::Rebuild()
+{
+	EXTRA_LLM_SCOPE(Splines);
+	LastCheckedFrame = GFrameCounter;
+
+	const USplineComponent* const SplineComp = Spline.Get();
+	if (!SplineComp || SplineComp->SplineCurves.ReparamTable.Points.Num() == 0)
+	{
+		KeySamples.Reset(0);
+		DistanceSamples.Reset(0);
+		BuiltSplineHash = 0;
+		return;
+	}
+
+	BuiltSplineHash = UExtraFunctionalityLibrary::GetSplineCurvesHash(SplineComp);
+	SplineLength = SplineComp->GetSplineLength();
+	// The reparam table maps distance to input key, so its last entry is the highest input key(including the closing segment of a loop)
+	MaxInputKey = SplineComp->SplineCurves.ReparamTable.Points.Last().OutVal;
+
+	const int32 NumSegments = FMath::Max(1, FMath::CeilToInt(MaxInputKey));
+
+	// Input key table, keep doubling the resolution until it's accurate enough
+	for (int32 SamplesPerSegment = ExtraSplineSampleTable::MinSamplesPerSegment; ; SamplesPerSegment *= 2)
+	{
+		const int32 NumSamples = (NumSegments * SamplesPerSegment) + 1;
+		// A single point spline has no keys to spread the samples over, the spacing is kept above 0 since FindSampleIndex divides by it
+		KeySpacing = FMath::Max(MaxInputKey / (NumSamples - 1), KINDA_SMALL_NUMBER);
+
+		KeySamples.Reset(NumSamples);
+		for (int32 index = 0; index < NumSamples; index++)
+		{
+			KeySamples.AddSample(SplineComp, index * KeySpacing);
+		}
+
+		MeasuredPositionError = MeasureKeyTableError();
+		if (MeasuredPositionError <= MaxPositionError || SamplesPerSegment >= MaxSamplesPerSegment)
+		{
+			break;
+		}
+	}
+
+	// Distance table, same idea
+	const float KeyTableError = MeasuredPositionError;
+	for (int32 SamplesPerSegment = ExtraSplineSampleTable::MinSamplesPerSegment; ; SamplesPerSegment *= 2)
+	{
+		const int32 NumSamples = (NumSegments * SamplesPerSegment) + 1;
+		DistanceSpacing = FMath::Max(SplineLength / (NumSamples - 1), KINDA_SMALL_NUMBER);
+
+		DistanceSamples.Reset(NumSamples);
+		for (int32 index = 0; index < NumSamples; index++)
+		{
+			DistanceSamples.AddSample(SplineComp, SplineComp->SplineCurves.ReparamTable.Eval(index * DistanceSpacing, 0.0f));
+		}
+
+		MeasuredPositionError = MeasureDistanceTableError();
+		if (MeasuredPositionError <= MaxPositionError || SamplesPerSegment >= MaxSamplesPerSegment)
+		{
+			break;
+		}
+	}
+	MeasuredPositionError = FMath::Max(MeasuredPositionError, KeyTableError);
+
+	if (MeasuredPositionError > MaxPositionError)
+	{
+		UE_LOG(LogExtraSplineSampleTable, Warning, TEXT("Sample table for %s hit the sample cap, error is %f instead of %f"),
+			*GetNameSafe(SplineComp), MeasuredPositionError, MaxPositionError);
+	}
+
+	UE_LOG(LogExtraSplineSampleTable, Verbose, TEXT("Built sample table for %s with %d key samples and %d distance samples"),
+		*GetNameSafe(SplineComp), KeySamples.Locations.Num(), DistanceSamples.Locations.Num());
+}
+
+void UExtraSplineSampleTable::ConditionalRebuild(bool bForceCheck)
+{
+	if (!bForceCheck && LastCheckedFrame == GFrameCounter)
+	{
+		return;
+	}
+	LastCheckedFrame = GFrameCounter;
+
+	if (const USplineComponent* const SplineComp = Spline.Get())
+	{
+		if (UExtraFunctionalityLibrary::GetSplineCurvesHash(SplineComp) != BuiltSplineHash)
+		{
+			Rebuild();
+		}
+	}
+}
+
+FTransform UExtraSplineSampleTable::GetComponentTransform() const
+{
+	if (const USplineComponent* const SplineComp = Spline.Get())
+	{
+		return SplineComp->GetComponentTransform();
+	}
+	return FTransform::Identity;
+}
+
+FVector UExtraSplineSampleTable::GetLocationAtInputKey(float InKey, ESplineCoordinateSpace::Type CoordinateSpace)
+{
+	ConditionalRebuild();
+	if (!IsValidTable())
+	{
+		return FVector::ZeroVector;
+	}
+
+	const FVector Location = SampleAtInputKey(InKey).Location;
+	return (CoordinateSpace == ESplineCoordinateSpace::World) ? GetComponentTransform().TransformPosition(Location) : Location;
+}
+
+FVector UExtraSplineSampleTable::GetTangentAtInputKey(float InKey, ESplineCoordinateSpace::Type CoordinateSpace)
+{
+	ConditionalRebuild();
+	if (!IsValidTable())
+	{
+		return FVector::ZeroVector;
+	}
+
+	const FVector Tangent = SampleAtInputKey(InKey).Tangent;
+	return (CoordinateSpace == ESplineCoordinateSpace::World) ? GetComponentTransform().TransformVector(Tangent) : Tangent;
+}
+
+FRotator UExtraSplineSampleTable::GetRotationAtInputKey(float InKey, ESplineCoordinateSpace::Type CoordinateSpace)
+{
+	ConditionalRebuild();
+	if (!IsValidTable())
+	{
+		return FRotator::ZeroRotator;
+	}
+
+	const FQuat Rotation = SampleAtInputKey(InKey).Rotation;
+	return ((CoordinateSpace == ESplineCoordinateSpace::World) ? (GetComponentTransform().GetRotation() * Rotation) : Rotation).Rotator();
+}
+
+FVector UExtraSplineSampleTable::GetScaleAtInputKey(float InKey)
+{
+	ConditionalRebuild();
+	if (!IsValidTable())
+	{
+		return FVector(1.0f);
+	}
+	return SampleAtInputKey(InKey).Scale;
+}
+
+float UExtraSplineSampleTable::GetRollAtInputKey(float InKey, ESplineCoordinateSpace::Type CoordinateSpace)
+{
+	ConditionalRebuild();
+	if (!IsValidTable())
+	{
+		return 0.0f;
+	}
+
+	const FExtraSplineSample Sample = SampleAtInputKey(InKey);
+	return (CoordinateSpace == ESplineCoordinateSpace::World) ? (GetComponentTransform().GetRotation() * Sample.Rotation).Rotator().Roll : Sample.Roll;
+}
+
+FTransform UExtraSplineSampleTable::GetTransformAtInputKey(float InKey, ESplineCoordinateSpace::Type CoordinateSpace, bool bUseScale)
+{
+	ConditionalRebuild();
+	if (!IsValidTable())
+	{
+		return FTransform::Identity;
+	}
+	return SampleToTransform(SampleAtInputKey(InKey), CoordinateSpace, GetComponentTransform(), bUseScale);
+}
+
+FVector UExtraSplineSampleTable::GetLocationAtDistance(float Distance, ESplineCoordinateSpace::Type CoordinateSpace)
+{
+	ConditionalRebuild();
+	if (!IsValidTable())
+	{
+		return FVector::ZeroVector;
+	}
+
+	const FVector Location = SampleAtDistance(Distance).Location;
+	return (CoordinateSpace == ESplineCoordinateSpace::World) ? GetComponentTransform().TransformPosition(Location) : Location;
+}
+
+FVector UExtraSplineSampleTable::GetTangentAtDistance(float Distance, ESplineCoordinateSpace::Type CoordinateSpace)
+{
+	ConditionalRebuild();
+	if (!IsValidTable())
+	{
+		return FVector::ZeroVector;
+	}
+
+	const FVector Tangent = SampleAtDistance(Distance).Tangent;
+	return (CoordinateSpace == ESplineCoordinateSpace::World) ? GetComponentTransform().TransformVector(Tangent) : Tangent;
+}
+
+FRotator UExtraSplineSampleTable::GetRotationAtDistance(float Distance, ESplineCoordinateSpace::Type CoordinateSpace)
+{
+	ConditionalRebuild();
+	if (!IsValidTable())
+	{
+		return FRotator::ZeroRotator;
+	}
+
+	const FQuat Rotation = SampleAtDistance(Distance).Rotation;
+	return ((CoordinateSpace == ESplineCoordinateSpace::World) ? (GetComponentTransform().GetRotation() * Rotation) : Rotation).Rotator();
+}
+
+FVector UExtraSplineSampleTable::GetScaleAtDistance(float Distance)
+{
+	ConditionalRebuild();
+	if (!IsValidTable())
+	{
+		return FVector(1.0f);
+	}
+	return SampleAtDistance(Distance).Scale;
+}
+
+float UExtraSplineSampleTable::GetRollAtDistance(float Distance, ESplineCoordinateSpace::Type CoordinateSpace)
+{
+	ConditionalRebuild();
+	if (!IsValidTable())
+	{
+		return 0.0f;
+	}
+
+	const FExtraSplineSample Sample = SampleAtDistance(Distance);
+	return (CoordinateSpace == ESplineCoordinateSpace::World) ? (GetComponentTransform().GetRotation() * Sample.Rotation).Rotator().Roll : Sample.Roll;
+}
+
+FTransform UExtraSplineSampleTable::GetTransformAtDistance(float Distance, ESplineCoordinateSpace::Type CoordinateSpace, bool bUseScale)
+{
+	ConditionalRebuild();
+	if (!IsValidTable())
+	{
+		return FTransform::Identity;
+	}
+	return SampleToTransform(SampleAtDistance(Distance), CoordinateSpace, GetComponentTransform(), bUseScale);
+}
+
+float UExtraSplineSampleTable::GetInputKeyAtDistance(float Distance)
+{
+	ConditionalRebuild();
+	if (!IsValidTable())
+	{
+		return 0.0f;
+	}
+	return InputKeyAtDistance(Distance);
+}
+
+FExtraSplineSample UExtraSplineSampleTable::SampleAtInputKey(float InKey) const
+{
+	int32 Index;
+	float Alpha;
+	FindSampleIndex(InKey, KeySpacing, KeySamples.Locations.Num(), Index, Alpha);
+	return KeySamples.Interpolate(Index, Alpha);
+}
+
+FExtraSplineSample UExtraSplineSampleTable::SampleAtDistance(float Distance) const
+{
+	int32 Index;
+	float Alpha;
+	FindSampleIndex(Distance, DistanceSpacing, DistanceSamples.Locations.Num(), Index, Alpha);
+	return DistanceSamples.Interpolate(Index, Alpha);
+}
+
+float UExtraSplineSampleTable::InputKeyAtDistance(float Distance) const
+{
+	int32 Index;
+	float Alpha;
+	FindSampleIndex(Distance, DistanceSpacing, DistanceSamples.InputKeys.Num(), Index, Alpha);
+	return FMath::Lerp(DistanceSamples.InputKeys[Index], DistanceSamples.InputKeys[Index + 1], Alpha);
+}
+
+FTransform UExtraSplineSampleTable::SampleToTransform(const FExtraSplineSample& Sample, ESplineCoordinateSpace::Type CoordinateSpace,
+	const FTransform& ComponentTransform, bool bUseScale)
+{
+	const FTransform LocalTransform(Sample.Rotation, Sample.Location, bUseScale ? Sample.Scale : FVector(1.0f));
+	return (CoordinateSpace == ESplineCoordinateSpace::World) ? (LocalTransform * ComponentTransform) : LocalTransform;
+}
+
+void UExtraSplineSampleTable::FindSampleIndex(float Value, float Spacing, int32 NumSamples, int32& OutIndex, float& OutAlpha)
+{
+	const float Position = (Spacing > 0.0f) ? (FMath::Max(Value, 0.0f) / Spacing) : 0.0f;
+	OutIndex = FMath::Clamp(FMath::FloorToInt(Position), 0, FMath::Max(NumSamples - 2, 0));
+	OutAlpha = FMath::Clamp(Position - OutIndex, 0.0f, 1.0f);
+}
+
+float UExtraSplineSampleTable::MeasureKeyTableError() const
+{
+	const USplineComponent* const SplineComp = Spline.Get();
+	float MaxError = 0.0f;
+	for (int32 index = 0; index < (KeySamples.Locations.Num() - 1); index++)
+	{
+		const FVector Exact = SplineComp->GetLocationAtSplineInputKey((index + 0.5f) * KeySpacing, ESplineCoordinateSpace::Local);
+		const FVector Interpolated = (KeySamples.Locations[index] + KeySamples.Locations[index + 1]) * 0.5f;
+		MaxError = FMath::Max(MaxError, FVector::DistSquared(Exact, Interpolated));
+	}
+	return FMath::Sqrt(MaxError);
+}
+
+float UExtraSplineSampleTable::MeasureDistanceTableError() const
+{
+	const USplineComponent* const SplineComp = Spline.Get();
+	float MaxError = 0.0f;
+	for (int32 index = 0; index < (DistanceSamples.Locations.Num() - 1); index++)
+	{
+		const float MidKey = SplineComp->SplineCurves.ReparamTable.Eval((index + 0.5f) * DistanceSpacing, 0.0f);
+		const FVector Exact = SplineComp->GetLocationAtSplineInputKey(MidKey, ESplineCoordinateSpace::Local);
+		const FVector Interpolated = (DistanceSamples.Locations[index] + DistanceSamples.Locations[index + 1]) * 0.5f;
+		MaxError = FMath::Max(MaxError, FVector::DistSquared(Exact, Interpolated));
+	}
+	return FMath::Sqrt(MaxError);
+}
+
+void UExtraSplineSampleTable::FSampleChannels::Reset(int32 NewSize)
+{
+	Locations.Reset(NewSize);
+	Tangents.Reset(NewSize);
+	Rotations.Reset(NewSize);
+	Scales.Reset(NewSize);
+	Rolls.Reset(NewSize);
+	InputKeys.Reset(NewSize);
+}
+
+void UExtraSplineSampleTable::FSampleChannels::AddSample(const USplineComponent* InSpline, float InKey)
+{
+	const FQuat Rotation = InSpline->GetQuaternionAtSplineInputKey(InKey, ESplineCoordinateSpace::Local);
+	Locations.Add(InSpline->GetLocationAtSplineInputKey(InKey, ESplineCoordinateSpace::Local));
+	Tangents.Add(InSpline->GetTangentAtSplineInputKey(InKey, ESplineCoordinateSpace::Local));
+	Rotations.Add(Rotation);
+	Scales.Add(InSpline->GetScaleAtSplineInputKey(InKey));
+	Rolls.Add(Rotation.Rotator().Roll);
+	InputKeys.Add(InKey);
+}
+
+FExtraSplineSample UExtraSplineSampleTable::FSampleChannels::Interpolate(int32 Index, float Alpha) const
+{
+	FExtraSplineSample Sample;
+	Sample.Location = FMath::Lerp(Locations[Index], Locations[Index + 1], Alpha);
+	Sample.Tangent = FMath::Lerp(Tangents[Index], Tangents[Index + 1], Alpha);
+	Sample.Rotation = FQuat::FastLerp(Rotations[Index], Rotations[Index + 1], Alpha).GetNormalized();
+	Sample.Scale = FMath::Lerp(Scales[Index], Scales[Index + 1], Alpha);
+	// Rolls wrap at 180 so lerp the shortest way around
+	Sample.Roll = FRotator::NormalizeAxis(Rolls[Index] + (FRotator::NormalizeAxis(Rolls[Index + 1] - Rolls[Index]) * Alpha));
+	return Sample;
+}
@@ -5,6 +5,7 @@
 #include "Blueprint/WidgetLayoutLibrary.h"
 #include "Components/Widget.h"
 #include "Engine/Engine.h"
+#include "ExtraMemoryTracking.h"
 #include "Framework/Application/SlateApplication.h"
 #include "GenericPlatform/GenericApplication.h"
 #include "Runtime/Engine/Classes/Engine/UserInterfaceSettings.h"
@@ -71,6 +72,7 @@ UWidget * UExtraWidgetLibrary::GetFocusedWidget()
 
 void UExtraWidgetLibrary::GetAllWidgetsOfTypeInUserWidget(UUserWidget * ParentWidget, TSubclassOf<UWidget> WidgetClass, TArray<UWidget*>& FoundWidgets)
 {
+	EXTRA_LLM_SCOPE(Widgets);
 	FoundWidgets.Reset(); // Wipe the Found Widgets array
 	if (!ParentWidget)
 	{
@@ -122,6 +124,7 @@ UWidget * UExtraWidgetLibrary::GetRootParent(UWidget * InWidget)
 
 UWidget* UExtraWidgetLibrary::GetWidgetFromName(UUserWidget* InWidget, const FName InWidgetName, const bool bRecursive /*= true*/)
 {
+	EXTRA_LLM_SCOPE(Widgets);
 	if (InWidget && !InWidgetName.IsNone())
 	{
 		UWidget* FoundWidget = nullptr;
@@ -0,0 +1,387 @@
+#include "ExtraWorkScheduler.h"
+#include "Async/Async.h"
+#include "Components/SplineComponent.h"
+#include "Components/SplineMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "ExtraFunctionalityLibrary.h"
+#include "ExtraMemoryTracking.h"
+#include "ExtraScalability.h"
+#include "ExtraSplineMeshBuilder.h"
+
+DEFINE_LOG_CATEGORY(LogExtraWorkScheduler);
+
+UExtraWorkSchedulerSubsystem::UExtraWorkSchedulerSubsystem()
+{
+	FrameBudgetMs = 2.0f;
+	MaxConcurrentAsyncWork = 2;
+	LastHandle = 0;
+}
+
+void UExtraWorkSchedulerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	FrameBudgetMs = FExtraScalability::GetSplineBuildBudgetMs(FrameBudgetMs);
+}
+
+void UExtraWorkSchedulerSubsystem::Deinitialize()
+{
+	GameThreadQueue.Empty();
+	AsyncQueue.Empty();
+
+	// Worker thread work can reference things that are about to be torn down, so let it finish first
+	for (FWorkItem& Item : RunningAsyncWork)
+	{
+		*Item.bCancelled = true;
+	}
+	for (FWorkItem& Item : RunningAsyncWork)
+	{
+		Item.Future.Wait();
+	}
+	RunningAsyncWork.Empty();
+
+	Super::Deinitialize();
+}
+
+UExtraWorkSchedulerSubsystem* UExtraWorkSchedulerSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (const UWorld* const World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull))
+	{
+		if (const UGameInstance* const GameInstance = World->GetGameInstance())
+		{
+			return GameInstance->GetSubsystem<UExtraWorkSchedulerSubsystem>();
+		}
+	}
+	return nullptr;
+}
+
+int32 UExtraWorkSchedulerSubsystem::ScheduleSteppedWork(FName DebugName, EExtraWorkPriority Priority, FStepFunction&& Step)
+{
+	FWorkItem Item;
+	Item.Handle = MakeHandle();
+	Item.DebugName = DebugName;
+	Item.Priority = Priority;
+	Item.Progress = 0.0f;
+	Item.Step = MoveTemp(Step);
+
+	const int32 Handle = Item.Handle;
+	InsertByPriority(GameThreadQueue, MoveTemp(Item));
+	return Handle;
+}
+
+int32 UExtraWorkSchedulerSubsystem::ScheduleAsyncWork(FName DebugName, EExtraWorkPriority Priority, FAsyncFunction&& Work, TFunction<void()>&& OnGameThreadComplete)
+{
+	FWorkItem Item;
+	Item.Handle = MakeHandle();
+	Item.DebugName = DebugName;
+	Item.Priority = Priority;
+	Item.Progress = 0.0f;
+	Item.AsyncWork = MoveTemp(Work);
+	Item.OnGameThreadComplete = MoveTemp(OnGameThreadComplete);
+	Item.bCancelled = MakeShared<FThreadSafeBool, ESPMode::ThreadSafe>(false);
+
+	const int32 Handle = Item.Handle;
+	InsertByPriority(AsyncQueue, MoveTemp(Item));
+	StartQueuedAsyncWork();
+	return Handle;
+}
+
+bool UExtraWorkSchedulerSubsystem::CancelWork(int32 WorkHandle)
+{
+	const auto MatchesHandle = [WorkHandle](const FWorkItem& Item) { return Item.Handle == WorkHandle; };
+
+	if (GameThreadQueue.RemoveAll(MatchesHandle) > 0 || AsyncQueue.RemoveAll(MatchesHandle) > 0)
+	{
+		Stats.NumCancelledWork++;
+		return true;
+	}
+
+	// Running work is only flagged, it gets dropped once the worker thread is done with it
+	if (FWorkItem* const Running = RunningAsyncWork.FindByPredicate(MatchesHandle))
+	{
+		if (!*Running->bCancelled)
+		{
+			*Running->bCancelled = true;
+			Stats.NumCancelledWork++;
+			return true;
+		}
+	}
+	return false;
+}
+
+bool UExtraWorkSchedulerSubsystem::IsWorkPending(int32 WorkHandle) const
+{
+	float Progress;
+	return GetWorkProgress(WorkHandle, Progress);
+}
+
+bool UExtraWorkSchedulerSubsystem::GetWorkProgress(int32 WorkHandle, float& OutProgress) const
+{
+	OutProgress = 1.0f;
+	const auto MatchesHandle = [WorkHandle](const FWorkItem& Item) { return Item.Handle == WorkHandle; };
+
+	if (const FWorkItem* const Found = GameThreadQueue.FindByPredicate(MatchesHandle))
+	{
+		OutProgress = Found->Progress;
+		return true;
+	}
+	if (AsyncQueue.ContainsByPredicate(MatchesHandle))
+	{
+		OutProgress = 0.0f;
+		return true;
+	}
+	if (const FWorkItem* const Running = RunningAsyncWork.FindByPredicate(MatchesHandle))
+	{
+		OutProgress = 0.0f;
+		return !*Running->bCancelled;
+	}
+	return false;
+}
+
+FExtraWorkSchedulerStats UExtraWorkSchedulerSubsystem::GetStats() const
+{
+	FExtraWorkSchedulerStats Result = Stats;
+	Result.NumPendingGameThreadWork = GameThreadQueue.Num();
+	Result.NumPendingAsyncWork = AsyncQueue.Num() + RunningAsyncWork.Num();
+	return Result;
+}
+
+void UExtraWorkSchedulerSubsystem::ResetStats()
+{
+	Stats = FExtraWorkSchedulerStats();
+}
+
+void UExtraWorkSchedulerSubsystem::Tick(float DeltaTime)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Hand finished worker thread work back
+	for (int32 index = RunningAsyncWork.Num(); index-- > 0;)
+	{
+		if (RunningAsyncWork[index].Future.IsReady())
+		{
+			FWorkItem Finished = MoveTemp(RunningAsyncWork[index]);
+			RunningAsyncWork.RemoveAt(index, 1, false);
+
+			if (!*Finished.bCancelled)
+			{
+				Stats.NumCompletedWork++;
+				if (Finished.OnGameThreadComplete)
+				{
+					Finished.OnGameThreadComplete();
+				}
+			}
+		}
+	}
+	StartQueuedAsyncWork();
+
+	// Step game thread work until the budget runs out
+	const double EndTime = StartTime + (FrameBudgetMs / 1000.0);
+	while (GameThreadQueue.Num() > 0 && FPlatformTime::Seconds() < EndTime)
+	{
+		// The step is moved out while it runs since it's allowed to schedule or cancel work, which changes the queue
+		const int32 Handle = GameThreadQueue[0].Handle;
+		FStepFunction Step = MoveTemp(GameThreadQueue[0].Step);
+		float Progress = GameThreadQueue[0].Progress;
+
+		const bool bFinished = Step(Progress);
+
+		const int32 Index = GameThreadQueue.IndexOfByPredicate([Handle](const FWorkItem& Item) { return Item.Handle == Handle; });
+		if (Index == INDEX_NONE)
+		{
+			// Cancelled itself
+			continue;
+		}
+
+		if (bFinished)
+		{
+			GameThreadQueue.RemoveAt(Index);
+			Stats.NumCompletedWork++;
+		}
+		else
+		{
+			GameThreadQueue[Index].Step = MoveTemp(Step);
+			GameThreadQueue[Index].Progress = Progress;
+		}
+	}
+
+	const float ElapsedMs = (float)((FPlatformTime::Seconds() - StartTime) * 1000.0);
+	Stats.LastFrameMs = ElapsedMs;
+	if (ElapsedMs > FrameBudgetMs)
+	{
+		Stats.NumBudgetOverruns++;
+		Stats.WorstOverrunMs = FMath::Max(Stats.WorstOverrunMs, ElapsedMs - FrameBudgetMs);
+	}
+}
+
+bool UExtraWorkSchedulerSubsystem::IsTickable() const
+{
+	return (GameThreadQueue.Num() > 0 || RunningAsyncWork.Num() > 0 || AsyncQueue.Num() > 0);
+}
+
+TStatId UExtraWorkSchedulerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UExtraWorkSchedulerSubsystem, STATGROUP_Tickables);
+}
+
+void UExtraWorkSchedulerSubsystem::InsertByPriority(TArray<FWorkItem>& Queue, FWorkItem&& Item)
+{
+	int32 InsertIndex = Queue.Num();
+	for (int32 index = 0; index < Queue.Num(); index++)
+	{
+		if (Queue[index].Priority < Item.Priority)
+		{
+			InsertIndex = index;
+			break;
+		}
+	}
+	Queue.Insert(MoveTemp(Item), InsertIndex);
+}
+
+int32 UExtraWorkSchedulerSubsystem::MakeHandle()
+{
+	// Skip 0 so Blueprints can use it as "no work"
+	LastHandle = (LastHandle == MAX_int32) ? 1 : (LastHandle + 1);
+	return LastHandle;
+}
+
+void UExtraWorkSchedulerSubsystem::StartQueuedAsyncWork()
+{
+	while (AsyncQueue.Num() > 0 && RunningAsyncWork.Num() < MaxConcurrentAsyncWork)
+	{
+		FWorkItem Item = MoveTemp(AsyncQueue[0]);
+		AsyncQueue.RemoveAt(0);
+
+		// Only the work and the cancel flag go to the worker, the item itself stays on the game thread
+		Item.Future = Async(EAsyncExecution::ThreadPool, [Work = MoveTemp(Item.AsyncWork), bCancelled = Item.bCancelled]()
+		{
+			if (!*bCancelled)
+			{
+				Work(*bCancelled);
+			}
+		});
+
+		UE_LOG(LogExtraWorkScheduler, Verbose, TEXT("Started worker thread work %s(%d)"), *Item.DebugName.ToString(), Item.Handle);
+		RunningAsyncWork.Add(MoveTemp(Item));
+	}
+}
+
+int32 UExtraWorkSchedulerSubsystem::ScheduleGetSubDirectories(const FString& InDir, bool bDeepSearch, EExtraWorkPriority Priority, FExtraSubDirectoriesDelegate OnComplete)
+{
+	// Only the file system is touched so the whole search can happen on a worker thread
+	TSharedRef<TArray<FString>, ESPMode::ThreadSafe> Result = MakeShared<TArray<FString>, ESPMode::ThreadSafe>();
+	return ScheduleAsyncWork(TEXT("GetSubDirectories"), Priority,
+		[Result, InDir, bDeepSearch](const FThreadSafeBool& bCancelled)
+		{
+			EXTRA_LLM_SCOPE(Files);
+			*Result = UExtraFunctionalityLibrary::GetSubDirectories(InDir, bDeepSearch);
+		},
+		[Result, OnComplete]()
+		{
+			OnComplete.ExecuteIfBound(*Result);
+		});
+}
+
+int32 UExtraWorkSchedulerSubsystem::ScheduleSnapAllSplinePointsToGround(USplineComponent* SplineComp, float TraceDistance, bool bTraceComplex,
+	ETraceTypeQuery TraceChannel, const TArray<AActor*>& ActorsToIgnore, EExtraWorkPriority Priority, FExtraWorkCompleteDelegate OnComplete)
+{
+	if (!SplineComp)
+	{
+		OnComplete.ExecuteIfBound(false);
+		return 0;
+	}
+
+	TWeakObjectPtr<USplineComponent> WeakSpline = SplineComp;
+	TArray<TWeakObjectPtr<AActor>> WeakActorsToIgnore(ActorsToIgnore);
+	int32 NextPoint = SplineComp->GetNumberOfSplinePoints();
+	const int32 NumPoints = NextPoint;
+
+	return ScheduleSteppedWork(TEXT("SnapAllSplinePointsToGround"), Priority,
+		[WeakSpline, WeakActorsToIgnore, NextPoint, NumPoints, TraceDistance, bTraceComplex, TraceChannel, OnComplete](float& OutProgress) mutable
+		{
+			USplineComponent* const Spline = WeakSpline.Get();
+			if (!Spline)
+			{
+				OnComplete.ExecuteIfBound(false);
+				return true;
+			}
+
+			// Same order as SnapAllSplinePointsToGround, last point first
+			if (NextPoint-- > 0)
+			{
+				TArray<AActor*> IgnoredActors;
+				IgnoredActors.Reserve(WeakActorsToIgnore.Num());
+				for (const TWeakObjectPtr<AActor>& Actor : WeakActorsToIgnore)
+				{
+					if (Actor.IsValid())
+					{
+						IgnoredActors.Add(Actor.Get());
+					}
+				}
+				UExtraFunctionalityLibrary::SnapSingleSplinePointToGround(Spline, NextPoint, TraceDistance, bTraceComplex, TraceChannel, IgnoredActors);
+			}
+
+			OutProgress = (NumPoints > 0) ? (1.0f - ((float)FMath::Max(NextPoint, 0) / NumPoints)) : 1.0f;
+			if (NextPoint <= 0)
+			{
+				OnComplete.ExecuteIfBound(true);
+				return true;
+			}
+			return false;
+		});
+}
+
+int32 UExtraWorkSchedulerSubsystem::ScheduleBuildSplineMeshesAlongSpline(USplineComponent* SplineComp, FExtraSplineConstructionInfo ConstructionInfo,
+	EExtraWorkPriority Priority, FExtraSplineMeshesDelegate OnComplete)
+{
+	EXTRA_LLM_SCOPE(SplineMeshes);
+	if (!SplineComp || !ConstructionInfo.SplineMesh || !SplineComp->GetWorld())
+	{
+		OnComplete.ExecuteIfBound(TArray<USplineMeshComponent*>());
+		return 0;
+	}
+
+	// Tiles are computed right away so only the component creation is stepped
+	TSharedRef<TArray<FExtraSplineMeshTile>> Tiles = MakeShared<TArray<FExtraSplineMeshTile>>();
+	FExtraSplineMeshBuilder::ComputeTiles(SplineComp, ConstructionInfo, *Tiles);
+	FExtraSplineMeshBuilder::DrawTilesDebug(SplineComp, ConstructionInfo, *Tiles);
+	TSharedRef<TArray<TWeakObjectPtr<USplineMeshComponent>>> SplineMeshes = MakeShared<TArray<TWeakObjectPtr<USplineMeshComponent>>>();
+	const TArray<UMaterialInterface*> Materials = FExtraSplineMeshBuilder::GetTileMaterials(ConstructionInfo);
+	TWeakObjectPtr<USplineComponent> WeakSpline = SplineComp;
+	int32 NextTile = 0;
+
+	return ScheduleSteppedWork(TEXT("BuildSplineMeshesAlongSpline"), Priority,
+		[WeakSpline, ConstructionInfo, Materials, Tiles, SplineMeshes, NextTile, OnComplete](float& OutProgress) mutable
+		{
+			USplineComponent* const Spline = WeakSpline.Get();
+			if (Spline && NextTile < Tiles->Num())
+			{
+				const FExtraSplineMeshTile& Tile = (*Tiles)[NextTile++];
+				SplineMeshes->Add(FExtraSplineMeshBuilder::CreateTileComponent(Spline, ConstructionInfo, Materials, Tile));
+			}
+
+			OutProgress = (Tiles->Num() > 0) ? ((float)NextTile / Tiles->Num()) : 1.0f;
+			if (!Spline || NextTile >= Tiles->Num())
+			{
+				if (Spline)
+				{
+					FExtraSplineMeshBuilder::CreateCollisionBodies(Spline, ConstructionInfo, *Tiles);
+				}
+
+				TArray<USplineMeshComponent*> Result;
+				Result.Reserve(SplineMeshes->Num());
+				for (const TWeakObjectPtr<USplineMeshComponent>& MeshComp : *SplineMeshes)
+				{
+					if (MeshComp.IsValid())
+					{
+						Result.Add(MeshComp.Get());
+					}
+				}
+				OnComplete.ExecuteIfBound(Result);
+				return true;
+			}
+			return false;
+		});
+}
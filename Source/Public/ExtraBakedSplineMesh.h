@@ -0,0 +1,98 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProceduralMeshComponent.h"
+#include "ExtraDataTypes.h"
+#include "ExtraBakedSplineMesh.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogExtraBakedSplineMesh, Log, All);
+
+class USplineComponent;
+
+/**
+* The same tiles BuildSplineMeshesAlongSpline makes, deformed on the CPU and merged into procedural mesh sections(one per material)
+* instead of a spline mesh component per tile, so a long spline costs a handful of draw calls.
+* Tiles are deformed in parallel, with TilesPerChunk above 0 the result is split into several components so the chunks can be culled separately.
+* The bake is only redone when the spline's curves, ConstructionInfo or TilesPerChunk change, and isn't saved(it's redone when the component is registered).
+* A bake that failed, like when the mesh has no render data, isn't retried until one of those changes or Bake is called.
+* The spline mesh needs Allow CPU Access turned on for the bake to work in packaged games.
+*/
+UCLASS(ClassGroup = (Rendering), meta = (BlueprintSpawnableComponent))
+class EXTRAFUNCTIONALITY_API UExtraBakedSplineMeshComponent : public UProceduralMeshComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	UExtraBakedSplineMeshComponent(const FObjectInitializer& ObjectInitializer);
+
+	/**
+	* Creates a baked spline mesh component attached to SplineComp and bakes it.
+	* @param TilesPerChunk How many tiles go into each component, 0 puts every tile into one component.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline|Baked")
+	static UExtraBakedSplineMeshComponent* BakeSplineMeshesAlongSpline(USplineComponent* SplineComp, FExtraSplineConstructionInfo ConstructionInfo,
+		int32 TilesPerChunk = 0, bool bRebakeWhenSplineChanges = true);
+
+	/** Spline to bake along, when not set the spline this component is attached to is used. */
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline|Baked")
+	void SetSpline(USplineComponent* SplineComp);
+
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline|Baked")
+	USplineComponent* GetSpline() const;
+
+	/** Bakes the mesh even if nothing changed, for example after changing ConstructionInfo. */
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline|Baked")
+	void Bake();
+
+	/** Bakes the mesh only if the spline or bake settings changed since the last bake, returns true if it baked. */
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline|Baked")
+	bool ConditionalRebake();
+
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline|Baked")
+	bool IsBakeOutOfDate() const;
+
+	/** Every component holding part of the bake, this component is always the first chunk */
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline|Baked")
+	TArray<UProceduralMeshComponent*> GetChunks() const;
+
+	/**
+	* The tiles to bake, same settings as BuildSplineMeshesAlongSpline.
+	* TilesPerCollisionBody groups tiles into a convex collision body each(0 is a body per tile), bUseComponentPool is ignored.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Extra Functionality Library|Spline|Baked")
+	FExtraSplineConstructionInfo ConstructionInfo;
+
+	/** How many tiles go into each component, 0 puts every tile into this component */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Extra Functionality Library|Spline|Baked", meta = (ClampMin = 0))
+	int32 TilesPerChunk;
+
+	/** Checks every frame if the spline changed and rebakes if it did */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Extra Functionality Library|Spline|Baked")
+	bool bRebakeWhenSplineChanges;
+
+	// UActorComponent interface
+	virtual void OnRegister() override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void OnComponentDestroyed(bool bDestroyingHierarchy) override;
+
+private:
+
+	/** Returns the component for ChunkIndex, creating it if needed */
+	UProceduralMeshComponent* GetOrCreateChunk(int32 ChunkIndex);
+	/** Sets the rendering and collision settings from ConstructionInfo on Chunk */
+	void SetupChunk(UProceduralMeshComponent* Chunk) const;
+	uint32 GetBakeHash() const;
+
+	UPROPERTY()
+	USplineComponent* Spline;
+
+	/** Chunks after the first, which this component holds */
+	UPROPERTY(Transient)
+	TArray<UProceduralMeshComponent*> ExtraChunks;
+
+	/** Hash of the spline and bake settings at the last bake, 0 if never baked. Not saved since ExtraChunks aren't either */
+	UPROPERTY(Transient)
+	uint32 BakedHash;
+
+};
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ExtraComponentLookup.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogExtraComponentLookup, Log, All);
+
+class AActor;
+class UActorComponent;
+
+/**
+* Caches each actor's components by name the first time they're looked up, so repeated lookups are a map find instead of a scan.
+* An actor's cache is rebuilt when its component count changes, a cached component that was renamed, destroyed or
+* moved to another actor is never returned, and a name missing from the cache is searched for on the actor before it's reported
+* as not found, so renamed and swapped components are found without calling InvalidateActor.
+*
+* Lookups by class are indexed per actor class and component signature(a hash of the names and classes of an actor's components,
+* cached with the actor's components), the names of the components matching a queried class are recorded from the first actor
+* with that signature and found on later actors by name without checking each component's class.
+* Actors whose components were changed at runtime or by the construction script get their own slots under their own signature.
+*/
+UCLASS()
+class EXTRAFUNCTIONALITY_API UExtraComponentLookupSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UExtraComponentLookupSubsystem();
+
+	virtual void Deinitialize() override;
+
+	/** Helper for getting the lookup cache from any world context object, returns null if the world is invalid. */
+	static UExtraComponentLookupSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Returns the component of Actor named ComponentName, using the actor's world cache if there is one. */
+	static UActorComponent* FindComponentByName(AActor* Actor, FName ComponentName);
+
+	/** Cached lookup of the component of Actor named ComponentName, null if there isn't one. */
+	UActorComponent* FindComponent(AActor* Actor, FName ComponentName);
+
+	/**
+	* Looks up every name in ComponentNames at once.
+	* @param OutComponents Matches ComponentNames, with null for the names that weren't found.
+	* @return Returns how many of the names were found.
+	*/
+	int32 FindComponents(AActor* Actor, const TArray<FName>& ComponentNames, TArray<UActorComponent*>& OutComponents);
+
+	/** Returns the component of Actor that is a ComponentClass, using the actor's world index if there is one. */
+	static UActorComponent* FindComponentByClass(AActor* Actor, TSubclassOf<UActorComponent> ComponentClass);
+
+	/** Indexed lookup of the first component of Actor that is a ComponentClass, null if there isn't one. */
+	UActorComponent* FindComponentOfClass(AActor* Actor, TSubclassOf<UActorComponent> ComponentClass);
+
+	/**
+	* Indexed lookup of every component of Actor that is a ComponentClass.
+	* @return Returns how many were found.
+	*/
+	int32 FindComponentsOfClass(AActor* Actor, TSubclassOf<UActorComponent> ComponentClass, TArray<UActorComponent*>& OutComponents);
+
+	/** Forgets Actor's cached components, they're found again on the next lookup. */
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Components")
+	void InvalidateActor(AActor* Actor);
+
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Components")
+	void ClearCache();
+
+private:
+
+	struct FActorEntry
+	{
+		TMap<FName, TWeakObjectPtr<UActorComponent>> ComponentsByName;
+		int32 NumComponents;
+		/** Signature of the names and classes of the actor's components when the entry was built */
+		uint64 Signature;
+	};
+
+	/** Names of the components that match each queried component class, for every component signature seen on an actor class */
+	struct FActorClassEntry
+	{
+		TMap<uint64, TMap<TWeakObjectPtr<UClass>, TArray<FName>>> ComponentNamesBySignature;
+	};
+
+	/**
+	* Returns the names of Actor's components that are a ComponentClass, recording them from Actor if this is the first query for them
+	* on an actor with the same class and signature.
+	*/
+	const TArray<FName>& FindOrBuildClassSlots(AActor* Actor, FActorEntry& Entry, UClass* ComponentClass);
+	/** Finds the components named in Slots on Actor, returns false if any are gone or no longer a ComponentClass */
+	static bool ResolveClassSlots(AActor* Actor, UClass* ComponentClass, const TArray<FName>& Slots, TArray<UActorComponent*>& OutComponents, bool bFirstOnly);
+
+	/** Returns Actor's entry, building it if it's missing or the actor's components changed */
+	FActorEntry& FindOrBuildEntry(AActor* Actor, bool& bOutBuilt);
+	/**
+	* Searches Actor for a name its entry missed or had a stale component for, rebuilding the entry if it's out of date.
+	* Skips the search if the entry was already built during this lookup(bInOutBuilt).
+	*/
+	UActorComponent* FindUncachedComponent(AActor* Actor, FActorEntry& Entry, FName ComponentName, bool bWasCached, bool& bInOutBuilt);
+	void BuildEntry(AActor* Actor, FActorEntry& Entry);
+	/** Removes entries of destroyed actors once the cache has grown enough since the last purge */
+	void ConditionalPurge();
+
+	TMap<TWeakObjectPtr<AActor>, FActorEntry> Entries;
+	TMap<TWeakObjectPtr<UClass>, FActorClassEntry> ClassEntries;
+	int32 PurgeThreshold;
+
+};
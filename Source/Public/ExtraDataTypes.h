@@ -119,6 +119,22 @@ public:
 	TEnumAsByte<EObjectTypeQuery> ObjectType;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Construction|Collision")
 	TEnumAsByte<EComponentMobility::Type> Mobility;
+	/**
+	* When above 0 the tiles get no collision of their own, instead a single box is made for every N tiles that roughly covers them.
+	* Cuts the amount of physics bodies on long splines down a lot at the cost of accuracy around tight curves.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Construction|Collision", meta = (ClampMin = 0))
+	int32 TilesPerCollisionBody;
+
+	/** Distance the tiles stop being drawn at, 0 means they're never culled by distance */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Construction|Rendering", meta = (ClampMin = 0.0f))
+	float CullDistance;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Construction|Rendering")
+	uint8 bCastShadow : 1;
+
+	/** Takes the spline mesh components from the world's spline mesh pool instead of creating new ones, give them back with ReleaseSplineMeshes */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Construction|Pooling")
+	uint8 bUseComponentPool : 1;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Construction|Debug")
 	uint8 bDebugMode : 1;
@@ -128,6 +144,7 @@ public:
 		float ArrowSize;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Construction|Debug", meta = (ClampMin = 0.0f))
 		float ArrowThickness;
+	/** Seconds the debug arrows stay, 0 shows them for a single frame. Rebuilding the same spline replaces its arrows */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Construction|Debug", meta = (ClampMin = 0.0f))
 		float DebugTime;
 
@@ -135,3 +152,468 @@ public:
 
 };
 
+/** Settings for ScatterInstancesAlongSpline */
+USTRUCT(BlueprintType)
+struct FExtraSplineScatterInfo
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Scatter")
+	UStaticMesh* Mesh;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Scatter")
+	TArray<UMaterialInterface*> OptionalMaterials;
+	/** Distance along the spline between instances */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Scatter", meta = (ClampMin = 1.0f))
+	float Spacing;
+	/** Distance along the spline of the first instance */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Scatter", meta = (ClampMin = 0.0f))
+	float StartOffset;
+	/** When true instances are rotated to follow the spline, otherwise only the rotation jitter is applied */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Scatter")
+	uint8 bAlignToSpline : 1;
+
+	/** Random offset(+/-) in the spline's forward, right and up directions */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Scatter|Jitter")
+	FVector LocationJitter;
+	/** Random rotation(+/-) added to each instance */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Scatter|Jitter")
+	FRotator RotationJitter;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Scatter|Jitter", meta = (ClampMin = 0.0f))
+	float MinScale;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Scatter|Jitter", meta = (ClampMin = 0.0f))
+	float MaxScale;
+	/** Each instance's jitter only depends on the seed and its index, so changing the spline doesn't reshuffle every instance */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Scatter|Jitter")
+	int32 RandomSeed;
+
+	/** Traces down from each instance and places it on whatever was hit, instances that hit nothing stay on the spline */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Scatter|Ground")
+	uint8 bSnapToGround : 1;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Scatter|Ground", meta = (ClampMin = 0.0f))
+	float GroundTraceDistance;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Scatter|Ground")
+	TEnumAsByte<ETraceTypeQuery> GroundChannel;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Scatter|Ground")
+	uint8 bTraceComplex : 1;
+	/** Uses the ground height cache(static geometry only) before tracing */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Scatter|Ground")
+	uint8 bUseGroundHeightCache : 1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Scatter|Collision")
+	TEnumAsByte<ECollisionEnabled::Type> CollisionEnabled;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Scatter|Collision")
+	TEnumAsByte<EObjectTypeQuery> ObjectType;
+
+	/** Distance the instances stop being drawn at, 0 means they're never culled by distance */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Scatter|Rendering", meta = (ClampMin = 0.0f))
+	float CullDistance;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Scatter|Rendering")
+	uint8 bCastShadow : 1;
+
+	FExtraSplineScatterInfo();
+
+};
+
+USTRUCT(BlueprintType)
+struct FExtraReplayInfo
+{
+	GENERATED_BODY()
+public:
+
+	/** The unique name the replay streamer uses to identify this replay */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Replay")
+	FString Name;
+	/** The descriptive name given when the replay was recorded, does not have to be unique */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Replay")
+	FString FriendlyName;
+	/** When the replay was recorded */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Replay")
+	FDateTime Timestamp;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Replay")
+	float DurationInSeconds;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Replay")
+	int64 SizeInBytes;
+	/** True if the replay is still being recorded */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Replay")
+	uint8 bIsLive : 1;
+	/** The users that were added to this replay through AddUserToReplay while it was recording */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Replay")
+	TArray<FString> Users;
+
+	FExtraReplayInfo();
+
+};
+
+UENUM(BlueprintType)
+enum class EExtraWorkPriority : uint8
+{
+	Low,
+	Normal,
+	High,
+	/** Runs before anything else, use for work something is waiting on this frame */
+	Critical
+};
+
+/** Which parts of a component's render data the render dirty queue marks dirty */
+UENUM(BlueprintType, meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class EExtraRenderDirtyFlags : uint8
+{
+	None			= 0 UMETA(Hidden),
+	DynamicData		= 1 << 0,
+	Transform		= 1 << 1,
+	/** Recreates the render state, which also covers the transform and dynamic data */
+	RenderState		= 1 << 2,
+	All				= DynamicData | Transform | RenderState UMETA(Hidden)
+};
+ENUM_CLASS_FLAGS(EExtraRenderDirtyFlags);
+
+/** Counters from the render dirty queue */
+USTRUCT(BlueprintType)
+struct FExtraRenderDirtyStats
+{
+	GENERATED_BODY()
+public:
+
+	/** Every mark that was queued */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Render Dirty Queue")
+	int32 NumMarks;
+	/** Marks that didn't cost anything extra, since the component was already queued or a render state recreate already covered them */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Render Dirty Queue")
+	int32 NumRedundantMarks;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Render Dirty Queue")
+	int32 NumFlushedComponents;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Render Dirty Queue")
+	int32 NumFlushes;
+
+	FExtraRenderDirtyStats();
+
+};
+
+/** How the debug draw layer draws coordinate arrows */
+USTRUCT(BlueprintType)
+struct FExtraDebugArrowSettings
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Draw", meta = (ClampMin = 0.0f))
+	float ArrowLength;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Draw", meta = (ClampMin = 0.0f))
+	float ArrowSize;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Draw", meta = (ClampMin = 0.0f))
+	float ArrowThickness;
+	/** Forward vector(X) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Draw")
+	FLinearColor ForwardColor;
+	/** Right vector(Y) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Draw")
+	FLinearColor RightColor;
+	/** Up vector(Z) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Draw")
+	FLinearColor UpColor;
+	/** Seconds the arrows stay, 0 or less keeps them until they're removed */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Draw")
+	float Duration;
+	/** Arrows further than this from the view aren't drawn, 0 draws them at any distance */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Draw", meta = (ClampMin = 0.0f))
+	float CullDistance;
+
+	FExtraDebugArrowSettings();
+
+};
+
+/** What a spline follower does when it reaches either end of its spline */
+UENUM(BlueprintType)
+enum class EExtraSplineFollowEndBehavior : uint8
+{
+	/** Stays at the end until its distance or speed is changed */
+	Stop,
+	/** Wraps around to the other end */
+	Loop,
+	/** Turns around and heads back */
+	PingPong
+};
+
+/** Counters from the work scheduler, frame times are in milliseconds */
+USTRUCT(BlueprintType)
+struct FExtraWorkSchedulerStats
+{
+	GENERATED_BODY()
+public:
+
+	/** Game thread work waiting for budget */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Work Scheduler")
+	int32 NumPendingGameThreadWork;
+	/** Worker thread work that is queued or running */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Work Scheduler")
+	int32 NumPendingAsyncWork;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Work Scheduler")
+	int32 NumCompletedWork;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Work Scheduler")
+	int32 NumCancelledWork;
+	/** How many frames went over the frame budget, a single step that takes longer than the budget can't be interrupted */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Work Scheduler")
+	int32 NumBudgetOverruns;
+	/** The most a frame has gone over the budget by */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Work Scheduler")
+	float WorstOverrunMs;
+	/** Time spent on game thread work last frame */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Work Scheduler")
+	float LastFrameMs;
+
+	FExtraWorkSchedulerStats();
+
+};
+
+/** Counters from the spline mesh pool */
+USTRUCT(BlueprintType)
+struct FExtraComponentPoolStats
+{
+	GENERATED_BODY()
+public:
+
+	/** Components sitting in the pool waiting to be reused */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Component Pool")
+	int32 NumPooled;
+	/** Acquires that reused a pooled component */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Component Pool")
+	int32 NumHits;
+	/** Acquires that had to create a new component */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Component Pool")
+	int32 NumMisses;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Component Pool")
+	int32 NumReleased;
+	/** Released components that were destroyed because the pool was full */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Component Pool")
+	int32 NumDestroyedOverCap;
+
+	FExtraComponentPoolStats();
+
+};
+
+/** What SimplifySpline did to a spline */
+USTRUCT(BlueprintType)
+struct FExtraSplineSimplifyResult
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Spline Simplify")
+	int32 OriginalNumPoints;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Spline Simplify")
+	int32 NumPoints;
+	/** Furthest the simplified spline measured from the original one */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Spline Simplify")
+	float MaxPositionDeviation;
+	/** Largest difference in degrees of direction or rotation measured against the original spline */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Spline Simplify")
+	float MaxAngleDeviation;
+	/** Largest difference of any axis of the scale measured against the original spline */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Spline Simplify")
+	float MaxScaleDeviation;
+
+	FExtraSplineSimplifyResult();
+
+};
+
+/** Rigid body states stored as parallel arrays, one entry per component that was read */
+USTRUCT(BlueprintType)
+struct FExtraRigidBodyStates
+{
+	GENERATED_BODY()
+public:
+
+	/** World space location of each body */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Physics")
+	TArray<FVector> Locations;
+	/** World space rotation of each body */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Physics")
+	TArray<FRotator> Rotations;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Physics")
+	TArray<FVector> LinearVelocities;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Physics")
+	TArray<FVector> AngularVelocitiesInRadians;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Physics")
+	TArray<bool> bIsSleeping;
+	/** False for components that were invalid or had no physics body, the other arrays are zeroed at that index */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Physics")
+	TArray<bool> bHasBody;
+
+	int32 Num() const { return Locations.Num(); }
+
+};
+
+/** Spline evaluations stored as parallel arrays, one entry per input key or distance that was evaluated */
+USTRUCT(BlueprintType)
+struct FExtraSplineTransforms
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Spline")
+	TArray<FVector> Locations;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Spline")
+	TArray<FRotator> Rotations;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Spline")
+	TArray<FVector> UpVectors;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Spline")
+	TArray<FVector> RightVectors;
+	/** Spline scale is always in local space, same as FindScaleAtSplineInputKey */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Spline")
+	TArray<FVector> Scales;
+
+	int32 Num() const { return Locations.Num(); }
+
+};
+
+
+/** 
+* A handle to an object in the object handle table, checking if it's still valid is an array lookup instead of a weak pointer resolve.
+* Handles of destroyed objects stay invalid even after their slot is reused, since each reuse bumps the slot's generation.
+*/
+USTRUCT(BlueprintType)
+struct FExtraObjectHandle
+{
+	GENERATED_BODY()
+public:
+
+	/** Slot in the handle table */
+	UPROPERTY()
+	int32 Index;
+	/** Generation of the slot when the handle was made, 0 for no handle */
+	UPROPERTY()
+	int32 Generation;
+
+	FExtraObjectHandle();
+	FExtraObjectHandle(int32 InIndex, int32 InGeneration);
+
+	/** True if this was ever set to an object, doesn't mean the object is still valid */
+	bool IsSet() const { return Generation != 0; }
+
+	/** Both halves packed into one value, for storing handles compactly */
+	uint64 ToPacked() const { return ((uint64)(uint32)Generation << 32) | (uint64)(uint32)Index; }
+	static FExtraObjectHandle FromPacked(uint64 Packed) { return FExtraObjectHandle((int32)(uint32)Packed, (int32)(uint32)(Packed >> 32)); }
+
+	bool operator==(const FExtraObjectHandle& Other) const { return Index == Other.Index && Generation == Other.Generation; }
+	bool operator!=(const FExtraObjectHandle& Other) const { return !(*this == Other); }
+	friend uint32 GetTypeHash(const FExtraObjectHandle& Handle) { return HashCombine(GetTypeHash(Handle.Index), GetTypeHash(Handle.Generation)); }
+
+};
+
+/** What the platform the game is running on can do, measured once when the module starts up */
+USTRUCT(BlueprintType)
+struct FExtraPlatformProfile
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Platform")
+	FString CPUBrand;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Platform")
+	int32 NumPhysicalCores;
+	/** Cores including hyperthreads */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Platform")
+	int32 NumLogicalCores;
+	/** Task graph workers the engine spawns on this platform, what parallel work is spread across */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Platform")
+	int32 NumWorkerThreads;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Platform")
+	int32 CacheLineSize;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Platform")
+	int32 TotalPhysicalMemoryMB;
+	/** Memory that was available at startup */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Platform")
+	int32 AvailablePhysicalMemoryMB;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Platform")
+	bool bHasSSE42;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Platform")
+	bool bHasAVX;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Platform")
+	bool bHasAVX2;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Platform")
+	bool bHasNeon;
+	/** Single thread score from a short math benchmark, 100 is roughly a desktop CPU from 2015 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Platform")
+	float CPUScore;
+	/** How long the benchmark took */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Platform")
+	float BenchmarkMs;
+
+	FExtraPlatformProfile();
+
+};
+
+/** One row of the scalability table, picked when the CPU benchmark scores at least MinScore */
+USTRUCT(BlueprintType)
+struct FExtraScalabilityTier
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scalability")
+	FName TierName;
+	/** Lowest combined benchmark score this tier is picked for */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scalability", meta = (ClampMin = 0.0f))
+	float MinScore;
+	/** Overall scalability level applied the first time this tier is picked, 0 is low and 3 is epic */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scalability", meta = (ClampMin = 0, ClampMax = 3))
+	int32 ScalabilityLevel;
+	/** Frame budget of the work scheduler, which builds spline meshes spread across frames */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scalability", meta = (ClampMin = 0.0f))
+	float SplineBuildBudgetMs;
+	/** Async ground traces batched functions issue per frame, 0 issues them all at once */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scalability", meta = (ClampMin = 0))
+	int32 TracesPerFrame;
+
+	FExtraScalabilityTier();
+	FExtraScalabilityTier(FName InTierName, float InMinScore, int32 InScalabilityLevel, float InSplineBuildBudgetMs, int32 InTracesPerFrame);
+
+};
+
+/** Result of the startup CPU benchmark */
+USTRUCT(BlueprintType)
+struct FExtraCPUBenchmarkResult
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Scalability")
+	float SingleThreadScore;
+	/** Score of every worker running the benchmark at once, grows with the number of cores */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Scalability")
+	float MultiThreadScore;
+	/** The two scores blended by the settings' multi thread weight, what the tiers are picked by */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Scalability")
+	float CombinedScore;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Scalability")
+	float BenchmarkMs;
+	/** True if the scores were loaded from the previous launch instead of measured */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Scalability")
+	bool bFromCache;
+	/** Index in the settings' tiers, -1 if there are none */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Scalability")
+	int32 TierIndex;
+
+	FExtraCPUBenchmarkResult();
+
+};
+
+/** Memory one of the plugin's low level memory tracker tags is using */
+USTRUCT(BlueprintType)
+struct FExtraMemoryTagUsage
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Memory")
+	FName TagName;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Memory")
+	int64 CurrentBytes;
+	/** Highest CurrentBytes seen, sampled about once a second */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Memory")
+	int64 PeakBytes;
+
+	FExtraMemoryTagUsage();
+
+};
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/LineBatchComponent.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ExtraDataTypes.h"
+#include "ExtraDebugDraw.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogExtraDebugDraw, Log, All);
+
+class USceneComponent;
+
+/**
+* A debug draw layer with its own line batcher, for drawing lots of debug arrows without rebuilding them every frame.
+* Each call adds every item at once and returns a handle, calling again with that handle replaces those lines in place.
+* The line batcher is only rebuilt when something was added, removed or expired, or a view moved far enough to change what's culled.
+* Culling uses every view the world rendered last frame(editor viewports and players alike), an item is drawn if it's in range of any of them.
+* Nothing is drawn in builds without debug drawing.
+*/
+UCLASS()
+class EXTRAFUNCTIONALITY_API UExtraDebugDrawSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	UExtraDebugDrawSubsystem();
+
+	virtual void Deinitialize() override;
+
+	/** Helper for getting the debug draw layer from any world context object, returns null if the world is invalid. */
+	static UExtraDebugDrawSubsystem* Get(const UObject* WorldContextObject);
+
+	/**
+	* Draws coordinate arrows at every transform in one go.
+	* @param Handle A handle a previous call returned to replace its arrows, 0 adds new ones.
+	* @return Returns the handle to update or remove the arrows with, 0 if nothing could be drawn.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Debug", meta = (DevelopmentOnly, AutoCreateRefTerm = "Settings"))
+	int32 DrawCoordinateArrowsAtTransforms(const TArray<FTransform>& Transforms, const FExtraDebugArrowSettings& Settings, int32 Handle = 0);
+
+	/** DrawCoordinateArrowsAtTransforms using each component's world transform, Offset is added to each location. */
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Debug", meta = (DevelopmentOnly, AutoCreateRefTerm = "Settings"))
+	int32 DrawCoordinateArrowsAtComponents(const TArray<USceneComponent*>& Components, FVector Offset, const FExtraDebugArrowSettings& Settings, int32 Handle = 0);
+
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Debug", meta = (DevelopmentOnly))
+	void RemoveDebugDraw(int32 Handle);
+
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Debug", meta = (DevelopmentOnly))
+	void ClearDebugDraws();
+
+	/** Returns the handle last kept for Object with SetObjectHandle, 0 if there isn't one or its arrows are gone. */
+	int32 GetObjectHandle(const UObject* Object) const;
+
+	/** Keeps Handle for Object, so code that draws for the same object again can replace its arrows instead of adding more. */
+	void SetObjectHandle(const UObject* Object, int32 Handle);
+
+	/** How far a view has to move before culled arrows are checked again */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Extra Functionality Library|Debug", meta = (ClampMin = 0.0f))
+	float CullUpdateDistance;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return Entries.Num() > 0 || bLinesDirty; }
+	virtual bool IsTickableInEditor() const override { return true; }
+	virtual TStatId GetStatId() const override;
+
+private:
+
+	/** The lines from one draw call, every item has the same number of lines */
+	struct FEntry
+	{
+		TArray<FBatchedLine> Lines;
+		TArray<FVector> ItemLocations;
+		int32 LinesPerItem;
+		float CullDistance;
+		/** World time the lines go away at, 0 for never */
+		float ExpireTime;
+		/** Entries are drawn at least once before they expire, so very short durations still show for a frame */
+		bool bDrawn;
+	};
+
+	int32 MakeHandle();
+	/** Returns false if the world didn't render any views last frame */
+	bool GetViewLocations(TArray<FVector>& OutLocations) const;
+	/** True if the number of views changed or any of them moved further than CullUpdateDistance since the last rebuild */
+	bool HaveViewsMoved(const TArray<FVector>& ViewLocations) const;
+	void RebuildLines();
+
+	UPROPERTY()
+	ULineBatchComponent* LineBatcher;
+
+	TMap<int32, FEntry> Entries;
+	TMap<TWeakObjectPtr<const UObject>, int32> ObjectHandles;
+	int32 LastHandle;
+	bool bLinesDirty;
+	/** True if the last rebuild had entries with a cull distance */
+	bool bUsesCulling;
+	TArray<FVector> LastViewLocations;
+
+};
@@ -17,6 +17,7 @@ DECLARE_LOG_CATEGORY_EXTERN(LogExtraFunctionalityLibrary, Log, All);
 class AGameMode;
 
 class USplineMeshComponent;
+class UHierarchicalInstancedStaticMeshComponent;
 
 class UCheckBox;
 class UUserWidget;
@@ -61,6 +62,35 @@ public:
 		meta = (Keywords = "type platform"))
 	static EPlatformType GetPlatformType();
 
+	/** 
+	* Returns what the platform's CPU and memory looked like when the game started, measured once at startup.
+	* The plugin's batched functions use this to decide how to split their work across threads.
+	*/
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Platform", 
+		meta = (Keywords = "cpu cores memory simd benchmark"))
+	static FExtraPlatformProfile GetPlatformProfile();
+
+	/** Returns the startup CPU benchmark's scores and the scalability tier they picked. */
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Platform", 
+		meta = (Keywords = "cpu benchmark scalability"))
+	static FExtraCPUBenchmarkResult GetCPUBenchmarkResult();
+
+	/** 
+	* Runs the CPU benchmark again, ignoring the cached result, and picks a scalability tier from it. 
+	* @param bApplyScalabilityLevel Also applies the tier's overall scalability level to the game user settings.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Platform", 
+		meta = (Keywords = "cpu benchmark scalability"))
+	static FExtraCPUBenchmarkResult RunCPUBenchmark(bool bApplyScalabilityLevel);
+
+	/** 
+	* Returns the current and peak memory of each of the plugin's memory tracker tags, in bytes. 
+	* Empty unless the game is run with -LLM, the same report is printed by the Extra.MemReport console command.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Platform", 
+		meta = (Keywords = "memory llm usage report"))
+	static TArray<FExtraMemoryTagUsage> GetMemoryTagUsage();
+
 	/**
 	* Returns true if this is a debug build (UE_BUILD_DEBUG), returns false otherwise.
 	*/
@@ -462,6 +492,86 @@ public:
 		static void SetAngularVelocityInRadiansToComponentBody(const UPrimitiveComponent* InComponent,
 			const FVector& NewAngVel, const bool bAddToCurrent);
 
+		/** 
+		* Adds force to each component's rigid body instance, all under a single physics scene write lock.
+		* @param Forces Parallel to Components, if it only has one entry that force is applied to every component.
+		*/
+		UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Physics|Batched")
+		static void AddForceToComponentBodies(const TArray<UPrimitiveComponent*>& Components,
+			const TArray<FVector>& Forces, const bool bAccelChange);
+
+		/** 
+		* Adds force at a position to each component's rigid body instance, all under a single physics scene write lock.
+		* @param Forces Parallel to Components, if it only has one entry that force is applied to every component.
+		* @param Positions Parallel to Components, if it only has one entry that position is used for every component.
+		* @param bLocalSpace If true applies the force in local space of the object, false will apply in world space.
+		*/
+		UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Physics|Batched")
+		static void AddForceAtPositionToComponentBodies(const TArray<UPrimitiveComponent*>& Components,
+			const TArray<FVector>& Forces, const TArray<FVector>& Positions, const bool bLocalSpace);
+
+		/** 
+		* Adds impulse at position to each component's rigid body instance, all under a single physics scene write lock.
+		* @param Impulses Parallel to Components, if it only has one entry that impulse is applied to every component.
+		* @param Positions Parallel to Components, if it only has one entry that position is used for every component.
+		*/
+		UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Physics|Batched")
+		static void AddImpulseAtPositionToComponentBodies(const TArray<UPrimitiveComponent*>& Components,
+			const TArray<FVector>& Impulses, const TArray<FVector>& Positions);
+
+		/** 
+		* Adds impulse to each component's rigid body instance, all under a single physics scene write lock.
+		* @param Impulses Parallel to Components, if it only has one entry that impulse is applied to every component.
+		*/
+		UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Physics|Batched")
+		static void AddImpulseToComponentBodies(const TArray<UPrimitiveComponent*>& Components,
+			const TArray<FVector>& Impulses, const bool bVelChange);
+
+		/** 
+		* Adds torque(in radians) to each component's rigid body instance, all under a single physics scene write lock.
+		* @param Torques Parallel to Components, if it only has one entry that torque is applied to every component.
+		*/
+		UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Physics|Batched")
+		static void AddTorqueInRadiansToComponentBodies(const TArray<UPrimitiveComponent*>& Components,
+			const TArray<FVector>& Torques, const bool bAccelChange);
+
+		/** 
+		* Adds an angular impulse(in radians) to each component's rigid body instance, all under a single physics scene write lock.
+		* @param Impulses Parallel to Components, if it only has one entry that impulse is applied to every component.
+		*/
+		UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Physics|Batched")
+		static void AddAngularImpulseInRadiansToComponentBodies(const TArray<UPrimitiveComponent*>& Components,
+			const TArray<FVector>& Impulses, const bool bVelChange);
+
+		/** 
+		* Handles setting the velocity of each component's rigid body instance, all under a single physics scene write lock.
+		* @param NewVels Parallel to Components, if it only has one entry that velocity is used for every component.
+		*/
+		UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Physics|Batched")
+		static void SetLinearVelocityToComponentBodies(const TArray<UPrimitiveComponent*>& Components,
+			const TArray<FVector>& NewVels, const bool bAddToCurrent);
+
+		/** 
+		* Handles setting the angular velocity of each component's rigid body instance, all under a single physics scene write lock.
+		* @param NewAngVels Parallel to Components, if it only has one entry that angular velocity is used for every component.
+		*/
+		UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Physics|Batched")
+		static void SetAngularVelocityInRadiansToComponentBodies(const TArray<UPrimitiveComponent*>& Components,
+			const TArray<FVector>& NewAngVels, const bool bAddToCurrent);
+
+		/** 
+		* Reads the rigid body state of every component in one pass, under a single physics scene read lock.
+		* Each array in OutStates is parallel to Components, components without a body are left zeroed with bHasBody false.
+		*/
+		UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Physics|Batched")
+		static void GetComponentBodyStates(const TArray<UPrimitiveComponent*>& Components, FExtraRigidBodyStates& OutStates);
+
+		/** 
+		* C++ version of GetComponentBodyStates that is safe to call off the game thread, 
+		* as long as the components are kept alive and their physics state isn't being created or destroyed while reading.
+		*/
+		static void ReadComponentBodyStates(TArrayView<UPrimitiveComponent* const> Components, FExtraRigidBodyStates& OutStates);
+
 #pragma endregion
 
 		/** Returns the relative location of a socket. */
@@ -482,12 +592,39 @@ public:
 
 		/** Checks if all objects inputted into the array are valid. False if empty, True if all objects are valid. */
 		UFUNCTION(BlueprintPure, Category = "Extra Functionality Library", meta = (Keywords = "valid isvalid"))
-			static bool AreObjectsValid(TArray<UObject*> Objects);
+			static bool AreObjectsValid(const TArray<UObject*>& Objects);
+
+		/** 
+		* Makes a handle for every object, for lists that are validated often, checking handles with the object handle table is an array lookup each.
+		* Null objects get unset handles.
+		*/
+		UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library", meta = (Keywords = "valid isvalid handle"))
+			static TArray<FExtraObjectHandle> MakeObjectHandles(const TArray<UObject*>& Objects);
 
 		/** Returns true if any actors are overlapping this component, will return false if component is invalid. */
 		UFUNCTION(BlueprintPure, Category = "Extra Functionality Library")
 			static bool IsOverlappingAnyActors(UPrimitiveComponent* InComp, bool bExcludeSelf = true);
 
+		/** 
+		* Same as IsOverlappingAnyActors but only counts actors of ActorClass overlapping with a component of one of ObjectTypes,
+		* leave either empty to not filter by it. Stops at the first match without gathering the overlapping actors.
+		*/
+		UFUNCTION(BlueprintPure, Category = "Extra Functionality Library", meta = (AutoCreateRefTerm = "ObjectTypes"))
+			static bool IsOverlappingAnyActorsFiltered(UPrimitiveComponent* InComp, TSubclassOf<AActor> ActorClass,
+				const TArray<TEnumAsByte<EObjectTypeQuery>>& ObjectTypes, bool bExcludeSelf = true);
+
+		/** 
+		* Checks IsOverlappingAnyActorsFiltered for every component at once, Results matches InComps. 
+		* Returns how many of the components are overlapping something.
+		*/
+		UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library", meta = (AutoCreateRefTerm = "ObjectTypes"))
+			static int32 AreOverlappingAnyActors(const TArray<UPrimitiveComponent*>& InComps, TArray<bool>& Results, 
+				TSubclassOf<AActor> ActorClass, const TArray<TEnumAsByte<EObjectTypeQuery>>& ObjectTypes, bool bExcludeSelf = true);
+
+		/** AreOverlappingAnyActors writing into a bit array instead. */
+		static int32 AreOverlappingAnyActorsBits(TArrayView<UPrimitiveComponent* const> InComps, TBitArray<>& Results, 
+			TSubclassOf<AActor> ActorClass, const TArray<TEnumAsByte<EObjectTypeQuery>>& ObjectTypes, bool bExcludeSelf = true);
+
 		/** Returns the amount of actors in the world that are of type SearchClass */
 		UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library",
 			meta = (WorldContext = "WorldContextObject"))
@@ -511,9 +648,32 @@ public:
 			static void FindComponentOfClass(AActor* InActor, 
 				TSubclassOf<UActorComponent> ComponentClass, UActorComponent*& FoundComponent, EExtraSwitch &Result);
 
+		/** 
+		* Finds every component of class on the inputted actor, the components matching a class are indexed per actor class 
+		* so actors of the same class don't have to be searched through. Returns how many were found.
+		*/
+		UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library", 
+			meta = (DeterminesOutputType = "ComponentClass", DynamicOutputParam = "FoundComponents"))
+			static int32 FindComponentsOfClass(AActor* InActor, 
+				TSubclassOf<UActorComponent> ComponentClass, TArray<UActorComponent*>& FoundComponents);
+
 		/** Marks multiple inputted component's render state dirty. */
 		UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library", meta = (DisplayName = "Mark Render Dirty (Array)"))
-		static void MarkRenderDity_Comps(TArray<USceneComponent*> InComps);
+		static void MarkRenderDity_Comps(const TArray<USceneComponent*>& InComps);
+
+		/** 
+		* Queues the inputted component to be marked render dirty once at the end of the frame, 
+		* marking the same component again before then just merges the flags instead of redoing the work.
+		* @param DirtyFlags EExtraRenderDirtyFlags to mark, defaults to all of them.
+		*/
+		UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library")
+		static bool MarkRenderDirtyDeferred(USceneComponent* InComp, 
+			UPARAM(meta = (Bitmask, BitmaskEnum = EExtraRenderDirtyFlags)) int32 DirtyFlags = 7);
+
+		/** Queues multiple inputted components to be marked render dirty once at the end of the frame, DirtyFlags defaults to all of them. */
+		UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library", meta = (DisplayName = "Mark Render Dirty Deferred (Array)"))
+		static void MarkRenderDirtyDeferred_Comps(const TArray<USceneComponent*>& InComps, 
+			UPARAM(meta = (Bitmask, BitmaskEnum = EExtraRenderDirtyFlags)) int32 DirtyFlags = 7);
 
 		/** 
 		* Returns axis values based on if inputs are pressed/released within InPlayerController.
@@ -583,6 +743,22 @@ public:
 			static bool FindActorComponentByName(AActor* ActorToSearchIn, 
 				const FString& CompName, UActorComponent*& FoundComp);
 
+		/** 
+		* Same as FindActorComponentByName but by FName, the actor's components are cached by name on the first lookup 
+		* so finding components on the same actor again doesn't search through them. Returns true if success, and false if otherwise.
+		*/
+		UFUNCTION(BlueprintPure, Category = "Extra Functionality Library")
+			static bool FindActorComponentByFName(AActor* ActorToSearchIn, 
+				FName CompName, UActorComponent*& FoundComp);
+
+		/** 
+		* Finds every component named in CompNames at once, FoundComps matches CompNames with None for the names that weren't found. 
+		* Returns how many of the names were found.
+		*/
+		UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library")
+			static int32 FindActorComponentsByNames(AActor* ActorToSearchIn, 
+				const TArray<FName>& CompNames, TArray<UActorComponent*>& FoundComps);
+
 		/** Gets the closest component to the inputted point(in world space) from the inputted array of components */
 		UFUNCTION(BlueprintPure, Category = "Extra Functionality Library")
 			static UPrimitiveComponent* GetClosestComponentToPoint(TArray<UPrimitiveComponent*> Comps, 
@@ -594,6 +770,7 @@ public:
 
 		/**
 		* Draws coordinate arrows at InComponent's world location for DebugDisplayTime's seconds if InComponent is valid.
+		* For lots of components use UExtraDebugDrawSubsystem::DrawCoordinateArrowsAtComponents instead, which batches them into one line batcher.
 		* @param ForwardColor Forward Vector of InComponent(X).
 		* @param RightColor Right Vector of InComponent(Y).
 		* @param UpColor Up Vector of InComponent(Z).
@@ -611,13 +788,30 @@ public:
 		* @param ActorsToIgnore Automatically adds the Spline Component's actor(ignores self)
 		* @param OptionalOffset -Optional- Offsets the actor's snap to point on the ground by this value
 		* @param bDrawDebug When true will show the trace using debug lines for DrawDebugTime's duration using the colors from TraceColor(Start to ImpactPoint or end if no hit) and TraceHitColor(ImpactPoint to End)
+		* @param bUseGroundHeightCache When true will use the ground height cache(static geometry only, ActorsToIgnore doesn't apply) and only trace if the cache has no ground within TraceDistance.
 		* @return Returns true if successfully snapped actor to ground, false if actor is invalid or hit nothing to snap to.
 		*/
 		UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library",
-			meta = (TraceDistance = "1000.0", AutoCreateRefTerm = "ActorsToIgnore", AdvancedDisplay = "TraceColor,TraceHitColor,DrawDebugTime"))
+			meta = (TraceDistance = "1000.0", AutoCreateRefTerm = "ActorsToIgnore", AdvancedDisplay = "TraceColor,TraceHitColor,DrawDebugTime,bUseGroundHeightCache"))
 			static bool SnapActorToGround(AActor* InActor, float TraceDistance, bool bTraceComplex,
 				ETraceTypeQuery GroundChannel, const TArray<AActor*>& ActorsToIgnore, FVector OptionalOffset, bool bDrawDebug = false,
-				FLinearColor TraceColor = FLinearColor::Red, FLinearColor TraceHitColor = FLinearColor::Green, float DrawDebugTime = 5.0f);
+				FLinearColor TraceColor = FLinearColor::Red, FLinearColor TraceHitColor = FLinearColor::Green, float DrawDebugTime = 5.0f, 
+				bool bUseGroundHeightCache = false);
+
+		/**
+		* Batched version of SnapActorToGround, all traces are issued asynchronously in one go and the hit actors are moved together once every trace has finished.
+		* Moves are made with deferred movement updates so each actor's overlaps and child transforms only update once.
+		* @param TraceDistance The distance to trace for
+		* @param GroundChannel The ground collision channel to trace against and will snap to
+		* @param ActorsToIgnore Each actor also ignores itself
+		* @param OptionalOffset -Optional- Offsets each actor's snap to point on the ground by this value
+		* @param SnappedActors Parallel to Actors, true if that actor was snapped to the ground.
+		*/
+		UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library",
+			meta = (Latent, LatentInfo = "LatentInfo", WorldContext = "WorldContextObject", TraceDistance = "1000.0", AutoCreateRefTerm = "ActorsToIgnore"))
+			static void SnapActorsToGround(const UObject* WorldContextObject, const TArray<AActor*>& Actors, float TraceDistance, bool bTraceComplex,
+				ETraceTypeQuery GroundChannel, const TArray<AActor*>& ActorsToIgnore, FVector OptionalOffset, TArray<bool>& SnappedActors, 
+				FLatentActionInfo LatentInfo);
 
 #pragma region Spline Component Stuff
 
@@ -638,12 +832,14 @@ public:
 		* @param TraceChannel The collision channels to trace against and will snap to
 		* @param ActorsToIgnore Automatically adds the Spline Component's actor(ignores self)
 		* @param bDrawDebug When true will show the trace using debug lines for DrawDebugTime's duration using the colors from TraceColor(Start to ImpactPoint or end if no hit) and TraceHitColor(ImpactPoint to End)
+		* @param bUseGroundHeightCache When true will use the ground height cache(static geometry only, ActorsToIgnore doesn't apply) and only trace if the cache has no ground within TraceDistance.
 		*/
 		UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline", 
-			meta = (TraceDistance = "1000.0", AutoCreateRefTerm = "ActorsToIgnore", AdvancedDisplay = "TraceColor,TraceHitColor,DrawDebugTime"))
+			meta = (TraceDistance = "1000.0", AutoCreateRefTerm = "ActorsToIgnore", AdvancedDisplay = "TraceColor,TraceHitColor,DrawDebugTime,bUseGroundHeightCache"))
 		static void SnapAllSplinePointsToGround(USplineComponent* SplineComp, float TraceDistance, bool bTraceComplex, 
 			ETraceTypeQuery TraceChannel, const TArray<AActor*>& ActorsToIgnore, bool bDrawDebug = false,
-			FLinearColor TraceColor = FLinearColor::Red, FLinearColor TraceHitColor = FLinearColor::Green, float DrawDebugTime = 5.0f);
+			FLinearColor TraceColor = FLinearColor::Red, FLinearColor TraceHitColor = FLinearColor::Green, float DrawDebugTime = 5.0f,
+			bool bUseGroundHeightCache = false);
 
 		/**
 		* Attempts to snap a single spline point in the inputted spline component to the ground(which is really just a down direction).
@@ -651,12 +847,14 @@ public:
 		* @param TraceChannel The collision channels to trace against and will snap to
 		* @param ActorsToIgnore Automatically adds the Spline Component's actor(ignores self)
 		* @param bDrawDebug When true will show the trace using debug lines for DrawDebugTime's duration using the colors from TraceColor(Start to ImpactPoint or end if no hit) and TraceHitColor(ImpactPoint to End)
+		* @param bUseGroundHeightCache When true will use the ground height cache(static geometry only, ActorsToIgnore doesn't apply) and only trace if the cache has no ground within TraceDistance.
 		*/
 		UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline",
-			meta = (TraceDistance = "1000.0", AutoCreateRefTerm = "ActorsToIgnore", AdvancedDisplay = "TraceColor,TraceHitColor,DrawDebugTime"))
+			meta = (TraceDistance = "1000.0", AutoCreateRefTerm = "ActorsToIgnore", AdvancedDisplay = "TraceColor,TraceHitColor,DrawDebugTime,bUseGroundHeightCache"))
 			static void SnapSingleSplinePointToGround(USplineComponent* SplineComp, int32 SplinePointToSnap, float TraceDistance, bool bTraceComplex,
 				ETraceTypeQuery TraceChannel, const TArray<AActor*>& ActorsToIgnore, bool bDrawDebug = false,
-				FLinearColor TraceColor = FLinearColor::Red, FLinearColor TraceHitColor = FLinearColor::Green, float DrawDebugTime = 5.0f);
+				FLinearColor TraceColor = FLinearColor::Red, FLinearColor TraceHitColor = FLinearColor::Green, float DrawDebugTime = 5.0f,
+				bool bUseGroundHeightCache = false);
 
 		/** Get location along spline at the provided input key value */
 		UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline")
@@ -698,10 +896,64 @@ public:
 		UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline")
 			static void FindLocationAndRotationAtSplineInputKey(FVector& Location, FRotator& Rotation, USplineComponent* SplineComp, float InKey, ESplineCoordinateSpace::Type CoordinateSpace);
 
+		/** 
+		* Evaluates the spline at every input key in one call, large amounts of keys are spread across worker threads.
+		* Each array in OutTransforms is parallel to InKeys.
+		*/
+		UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline|Bulk")
+			static void FindTransformsAtSplineInputKeys(USplineComponent* SplineComp, const TArray<float>& InKeys, 
+				ESplineCoordinateSpace::Type CoordinateSpace, FExtraSplineTransforms& OutTransforms);
+
+		/** 
+		* Evaluates the spline at every distance along the spline in one call, large amounts of distances are spread across worker threads.
+		* Each array in OutTransforms is parallel to Distances.
+		*/
+		UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline|Bulk")
+			static void FindTransformsAtDistancesAlongSpline(USplineComponent* SplineComp, const TArray<float>& Distances, 
+				ESplineCoordinateSpace::Type CoordinateSpace, FExtraSplineTransforms& OutTransforms);
+
+		/** 
+		* C++ version of the bulk spline evaluation, Values are input keys or distances depending on bValuesAreDistances.
+		* Safe to call off the game thread as long as the spline isn't modified while evaluating.
+		*/
+		static void EvaluateSplineTransforms(const USplineComponent* SplineComp, TArrayView<const float> Values, bool bValuesAreDistances,
+			ESplineCoordinateSpace::Type CoordinateSpace, FExtraSplineTransforms& OutTransforms);
+
 		UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline")
 			static TArray<USplineMeshComponent*> BuildSplineMeshesAlongSpline(
 			USplineComponent* SplineComp, FExtraSplineConstructionInfo ConstructionInfo);
 
+		/** Destroys the grouped collision boxes BuildSplineMeshesAlongSpline made when TilesPerCollisionBody was above 0, call before rebuilding. */
+		UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline")
+			static void DestroySplineCollisionBodies(USplineComponent* SplineComp);
+
+		/**
+		* Places undeformed instances of ScatterInfo.Mesh along the spline, all in a single hierarchical instanced static mesh component.
+		* @param ExistingComponent The component a previous call returned, if valid it's updated in place and only the instances that changed are touched.
+		* @return Returns the component holding the instances, attached to the spline.
+		*/
+		UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline")
+			static UHierarchicalInstancedStaticMeshComponent* ScatterInstancesAlongSpline(USplineComponent* SplineComp, 
+				FExtraSplineScatterInfo ScatterInfo, UHierarchicalInstancedStaticMeshComponent* ExistingComponent = nullptr);
+
+		/**
+		* Removes the spline points that aren't needed to stay within the tolerances of the original spline(Ramer-Douglas-Peucker on the curve).
+		* Kept points keep their location, rotation and scale, their tangents are scaled to the longer segments and become custom tangents so the shape holds.
+		* Points with constant interpolation are always kept.
+		* @param PositionTolerance Furthest the simplified spline can be from the original one.
+		* @param AngleTolerance Largest difference in degrees of the spline direction or rotation, 0 or less ignores angles.
+		* @param ScaleTolerance Largest difference of any axis of the spline scale, 0 or less ignores scale.
+		*/
+		UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline", meta = (PositionTolerance = "5.0", AngleTolerance = "5.0", ScaleTolerance = "0.05"))
+			static FExtraSplineSimplifyResult SimplifySpline(USplineComponent* SplineComp, float PositionTolerance = 5.0f, float AngleTolerance = 5.0f, 
+				float ScaleTolerance = 0.05f);
+
+		/**
+		* Hashes every point of the spline's curves along with its loop and up vector settings.
+		* Cheap enough to call every frame to find out if a spline changed since something was built from it.
+		*/
+		static uint32 GetSplineCurvesHash(const USplineComponent* SplineComp);
+
 #pragma endregion
 
 #pragma region Replay System Stuff
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "WorldCollision.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ExtraGroundHeightCache.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogExtraGroundHeightCache, Log, All);
+
+class ULevel;
+class UPrimitiveComponent;
+
+/**
+* Caches the height of static geometry on a grid so repeated ground queries don't need to trace.
+* The grid is split into tiles that are only sampled(traced top down against static geometry) the first time a query lands in them,
+* queries are then answered with a bilinear lookup of the 4 surrounding samples.
+* Tiles are sampled with async traces, so queries fail(and callers trace directly) until a new tile's traces come back a frame later.
+* Tiles are thrown away when levels are added or removed, when actors with static collision are spawned, and in the editor when
+* static geometry is moved or modified(like sculpting a landscape).
+* Changing static collision at runtime in any other way, like editing a landscape's heightfield, destroying a static actor or
+* turning its collision on or off, isn't noticed, call InvalidateActor, InvalidateComponent or InvalidateBounds after doing so.
+*/
+UCLASS()
+class EXTRAFUNCTIONALITY_API UExtraGroundHeightCacheSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UExtraGroundHeightCacheSubsystem();
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/**
+	* Gets the height of the highest static surface at Location's X and Y.
+	* Starts sampling the tile Location is in if it hasn't been yet.
+	* @return Returns false if the tile is still being sampled, there was no ground around Location or the surrounding samples are too far apart
+	* to be interpolated(like at the edge of a cliff or wall).
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Ground Cache")
+	bool GetGroundHeight(const FVector& Location, ETraceTypeQuery TraceChannel, bool bTraceComplex, float& OutHeight);
+
+	/** Changes the grid settings, throws away every cached tile since they were sampled with the old settings. */
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Ground Cache")
+	void Configure(float InCellSize = 100.0f, int32 InCellsPerTile = 32, float InMinHeight = -100000.0f, float InMaxHeight = 100000.0f);
+
+	/** Throws away every cached tile. */
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Ground Cache")
+	void InvalidateAll();
+
+	/** Throws away the cached tiles that overlap Bounds(only X and Y are used). */
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Ground Cache")
+	void InvalidateBounds(const FBox& Bounds);
+
+	/** Throws away the cached tiles under the static colliding components of Actor, call it before destroying the actor or after changing its collision. */
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Ground Cache")
+	void InvalidateActor(AActor* Actor);
+
+	/** Throws away the cached tiles under Component if it's static and has collision, like a landscape collision component whose heights changed. */
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Ground Cache")
+	void InvalidateComponent(UPrimitiveComponent* Component);
+
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Ground Cache")
+	int32 GetNumCachedTiles() const { return Tiles.Num(); }
+
+	/** Returns the distance between samples */
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Ground Cache")
+	float GetCellSize() const { return CellSize; }
+
+	/** Cached tiles past this amount get thrown away, least recently used first. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Extra Functionality Library|Ground Cache", meta = (ClampMin = 1))
+	int32 MaxCachedTiles;
+
+	/** If the 4 samples around a query differ in height by more than this, the query fails instead of interpolating across a wall. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Extra Functionality Library|Ground Cache", meta = (ClampMin = 0.0f))
+	float MaxInterpolatedHeightDifference;
+
+	/** Helper for getting the cache from any world context object, returns null if the world is invalid. */
+	static UExtraGroundHeightCacheSubsystem* Get(const UObject* WorldContextObject);
+
+private:
+
+	struct FTile
+	{
+		/** (CellsPerTile + 1)^2 heights, NoGroundHeight where nothing was hit */
+		TArray<float> Heights;
+		uint64 LastUsedFrame;
+		/** Tells the traces of a tile apart from ones of an invalidated tile that had the same key */
+		uint32 TileId;
+		/** The tile can't be used until all of its traces came back */
+		int32 NumPendingTraces;
+	};
+
+	/** Packs the tile coordinate and trace settings into a key, since different channels see different ground */
+	static uint64 MakeTileKey(const FIntPoint& TileCoord, ETraceTypeQuery TraceChannel, bool bTraceComplex);
+	static FIntPoint GetTileCoordFromKey(uint64 Key);
+
+	const FTile& FindOrSampleTile(const FIntPoint& TileCoord, ETraceTypeQuery TraceChannel, bool bTraceComplex);
+	/** Issues an async trace for every sample of Tile */
+	void SampleTile(FTile& Tile, uint64 Key, const FIntPoint& TileCoord, ETraceTypeQuery TraceChannel, bool bTraceComplex);
+	void OnSampleTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum, uint64 Key, uint32 TileId);
+	/** Height range the samples are traced over, MinHeight to MaxHeight clamped to the loaded levels' bounds */
+	void GetTraceHeights(float& OutTop, float& OutBottom);
+	void EvictTiles();
+
+	void OnLevelChanged(ULevel* InLevel, UWorld* InWorld);
+	void OnActorSpawned(AActor* InActor);
+#if WITH_EDITOR
+	void OnActorMoved(AActor* InActor);
+	/** Catches landscape sculpting and other edits to static geometry, they modify the components they change */
+	void OnObjectModified(UObject* InObject);
+#endif
+
+	TMap<uint64, FTile> Tiles;
+
+	float CellSize;
+	int32 CellsPerTile;
+	float MinHeight;
+	float MaxHeight;
+
+	uint32 LastTileId;
+	/** Bounds of the loaded levels' geometry, recalculated when levels change */
+	FBox GeometryBounds;
+	bool bGeometryBoundsDirty;
+
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+	FDelegateHandle ActorSpawnedHandle;
+#if WITH_EDITOR
+	FDelegateHandle ActorMovedHandle;
+	FDelegateHandle ObjectModifiedHandle;
+#endif
+
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "ExtraDataTypes.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogExtraMemoryTracking, Log, All);
+
+/**
+* First project tag the plugin's low level memory tracker tags use, define it in the project's target if the project's own tags overlap.
+* The plugin takes as many tags as EExtraLLMTag has entries.
+*/
+#ifndef EXTRA_LLM_TAG_START
+#define EXTRA_LLM_TAG_START ((int32)ELLMTag::ProjectTagStart + 64)
+#endif
+
+/** The plugin's memory tags, every feature tag rolls up into ExtraFunctionality in the LLM summary */
+enum class EExtraLLMTag : uint8
+{
+	ExtraFunctionality,
+	SplineMeshes,
+	Splines,
+	Widgets,
+	Files,
+	Replays,
+	Caches,
+	Count
+};
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+#define EXTRA_LLM_SCOPE(Tag) LLM_SCOPE((ELLMTag)(EXTRA_LLM_TAG_START + (int32)EExtraLLMTag::Tag))
+#else
+#define EXTRA_LLM_SCOPE(Tag)
+#endif
+
+/**
+* Registers the plugin's tags with the low level memory tracker and keeps the peak usage of each one.
+* Run with -LLM to track memory, the usage can be printed with the Extra.MemReport console command.
+*/
+class EXTRAFUNCTIONALITY_API FExtraMemoryTracking
+{
+public:
+
+	/** Called when the module starts up, before anything is allocated under the tags. */
+	static void RegisterTags();
+
+	static void UnregisterTags();
+
+	/** Returns false if the engine was built without the low level memory tracker or it isn't enabled. */
+	static bool IsTrackingMemory();
+
+	/** Returns the current and peak usage of every tag, empty if memory isn't being tracked. */
+	static TArray<FExtraMemoryTagUsage> GetTagUsage();
+
+	static void LogTagUsage();
+
+	static const TCHAR* GetTagName(EExtraLLMTag Tag);
+
+private:
+
+	/** Samples the tags so peaks between reports aren't missed */
+	static bool SamplePeaks(float DeltaTime);
+
+	static int64 PeakBytes[(int32)EExtraLLMTag::Count];
+	static FDelegateHandle SampleTickerHandle;
+
+};
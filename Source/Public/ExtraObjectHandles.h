@@ -0,0 +1,91 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "UObject/UObjectArray.h"
+#include "ExtraDataTypes.h"
+#include "ExtraObjectHandles.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogExtraObjectHandles, Log, All);
+
+/**
+* Hands out generation counted handles to objects, so large lists of cached objects can be validated without resolving weak pointers.
+* Slots are freed when their object is deleted, which bumps the slot's generation so every handle to it goes invalid.
+* Making the same object a handle twice returns the same handle. Only use this on the game thread.
+*/
+UCLASS()
+class EXTRAFUNCTIONALITY_API UExtraObjectHandleSubsystem : public UEngineSubsystem, public FUObjectArray::FUObjectDeleteListener
+{
+	GENERATED_BODY()
+
+public:
+
+	UExtraObjectHandleSubsystem();
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Returns null if the engine isn't up yet */
+	static UExtraObjectHandleSubsystem* Get();
+
+	/** Returns the handle of Object, adding it to the table if it isn't already. Returns an unset handle for null. */
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Object Handles")
+	FExtraObjectHandle MakeHandle(UObject* Object);
+
+	/** Returns the object Handle points to, null if it was destroyed, is pending kill or is unreachable. */
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Object Handles")
+	UObject* ResolveHandle(const FExtraObjectHandle& Handle) const;
+
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Object Handles")
+	bool IsHandleValid(const FExtraObjectHandle& Handle) const;
+
+	/**
+	* Checks every handle at once.
+	* @param OutResults Matches Handles.
+	* @return Returns how many of the handles are valid.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Object Handles")
+	int32 AreHandlesValid(const TArray<FExtraObjectHandle>& Handles, TArray<bool>& OutResults) const;
+
+	/** Returns true if every handle is valid, false if any aren't or Handles is empty. */
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Object Handles")
+	bool AreAllHandlesValid(const TArray<FExtraObjectHandle>& Handles) const;
+
+	/** Removes the invalid handles from Handles in place, keeping the order of the rest. Returns how many were removed. */
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Object Handles")
+	int32 CompactHandles(UPARAM(ref) TArray<FExtraObjectHandle>& Handles) const;
+
+	/** Objects currently in the table */
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Object Handles")
+	int32 GetNumHandles() const { return ObjectToIndex.Num(); }
+
+	// FUObjectDeleteListener interface
+	virtual void NotifyUObjectDeleted(const UObjectBase* Object, int32 Index) override;
+	virtual void OnUObjectArrayShutdown() override;
+
+private:
+
+	struct FSlot
+	{
+		const UObjectBase* Object;
+		int32 Generation;
+	};
+
+	FORCEINLINE const FSlot* FindSlot(const FExtraObjectHandle& Handle) const
+	{
+		if (Slots.IsValidIndex(Handle.Index) && Slots[Handle.Index].Generation == Handle.Generation && Slots[Handle.Index].Object)
+		{
+			return &Slots[Handle.Index];
+		}
+		return nullptr;
+	}
+
+	void StopListening();
+
+	TArray<FSlot> Slots;
+	TArray<int32> FreeSlots;
+	/** Lets the delete listener and MakeHandle find an object's slot without searching */
+	TMap<const UObjectBase*, int32> ObjectToIndex;
+	bool bListening;
+
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ExtraDataTypes.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogExtraPlatformProfile, Log, All);
+
+/**
+* Measures the platform once when the module starts up, and sizes the plugin's parallel work from it.
+* The profile can be printed with the Extra.PlatformProfile console command.
+*/
+class EXTRAFUNCTIONALITY_API FExtraPlatformProfiler
+{
+public:
+
+	/** Returns the profile, measuring it first if the module hasn't yet. */
+	static const FExtraPlatformProfile& GetProfile();
+
+	/** Measures the platform again, the benchmark takes a few milliseconds. */
+	static void BuildProfile();
+
+	static void LogProfile();
+
+	/** Runs one round of the benchmark on the calling thread and returns how long it took in seconds. */
+	static double RunBenchmarkRound();
+
+	/** Converts a benchmark round time into a score, 100 being the reference CPU. */
+	static float GetBenchmarkScore(double RoundSeconds);
+
+	/**
+	* Returns how many items each ParallelFor task should take, so there are a few tasks per worker thread
+	* without any task getting less than MinBatchSize items.
+	*/
+	static int32 GetBatchSize(int32 NumItems, int32 MinBatchSize);
+
+	/** Returns true if NumItems is too few to be worth spreading across threads, or this platform has no workers to spread it across. */
+	static bool ShouldForceSingleThread(int32 NumItems, int32 MinItemsForParallel);
+
+private:
+
+	static FExtraPlatformProfile Profile;
+	static bool bProfileBuilt;
+
+};
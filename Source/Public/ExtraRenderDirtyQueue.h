@@ -0,0 +1,63 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ExtraDataTypes.h"
+#include "ExtraRenderDirtyQueue.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogExtraRenderDirtyQueue, Log, All);
+
+class UActorComponent;
+
+/**
+* Collects render dirty marks during the frame and applies them once after actors have ticked.
+* A component marked several times in a frame is only marked once with all of the flags merged,
+* and transform/dynamic data marks are dropped when the render state is being recreated anyway.
+*/
+UCLASS()
+class EXTRAFUNCTIONALITY_API UExtraRenderDirtyQueueSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UExtraRenderDirtyQueueSubsystem();
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Helper for getting the queue from any world context object, returns null if the world is invalid. */
+	static UExtraRenderDirtyQueueSubsystem* Get(const UObject* WorldContextObject);
+
+	void QueueRenderDirty(UActorComponent* Component, EExtraRenderDirtyFlags Flags);
+
+	/** Queues Component to be marked dirty at the end of the frame, merged with anything already queued for it. */
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Render Dirty Queue", meta = (DisplayName = "Queue Render Dirty"))
+	void K2_QueueRenderDirty(UActorComponent* Component, UPARAM(meta = (Bitmask, BitmaskEnum = EExtraRenderDirtyFlags)) int32 Flags);
+
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Render Dirty Queue")
+	void QueueRenderDirtyComponents(const TArray<UActorComponent*>& Components, UPARAM(meta = (Bitmask, BitmaskEnum = EExtraRenderDirtyFlags)) int32 Flags);
+
+	/** Applies everything that's queued right away instead of waiting for the end of the frame. */
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Render Dirty Queue")
+	void Flush();
+
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Render Dirty Queue")
+	int32 GetNumQueued() const { return Queue.Num(); }
+
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Render Dirty Queue")
+	FExtraRenderDirtyStats GetStats() const { return Stats; }
+
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Render Dirty Queue")
+	void ResetStats();
+
+private:
+
+	void OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+
+	TMap<TWeakObjectPtr<UActorComponent>, EExtraRenderDirtyFlags> Queue;
+	FExtraRenderDirtyStats Stats;
+	FDelegateHandle PostActorTickHandle;
+
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "ExtraDataTypes.h"
+#include "ExtraReplayCatalog.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogExtraReplayCatalog, Log, All);
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnExtraReplayCatalogRefreshed, bool, bSucceeded);
+
+class INetworkReplayStreamer;
+struct FEnumerateStreamsResult;
+
+/**
+* Keeps a cached list of the replays available to the replay streamer.
+* The streamer is only asked to enumerate once per refresh, which only reads each replay's header(name, duration, size, date),
+* the result is cached in memory and in a small index file so the list is available instantly on the next launch.
+*/
+UCLASS()
+class EXTRAFUNCTIONALITY_API UExtraReplayCatalogSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UExtraReplayCatalogSubsystem();
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/**
+	* Asynchronously re-enumerates the replays from the replay streamer, OnCatalogRefreshed is called when finished.
+	* @param bForce If false and the catalog was refreshed less than MinRefreshInterval seconds ago, the cached list is kept and OnCatalogRefreshed is called right away.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Replay")
+	void RefreshCatalog(bool bForce = false);
+
+	/** Returns the cached replays, sorted from newest to oldest. */
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Replay")
+	const TArray<FExtraReplayInfo>& GetReplays() const { return Replays; }
+
+	/** Searches the cached replays for ReplayName. Returns true if found, false if otherwise. */
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Replay")
+	bool FindReplay(const FString& ReplayName, FExtraReplayInfo& OutInfo) const;
+
+	/** Returns true while waiting on the replay streamer to finish enumerating. */
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Replay")
+	bool IsRefreshing() const { return bRefreshInProgress; }
+
+	/** Called after every refresh request, with whether or not the streamer succeeded. */
+	UPROPERTY(BlueprintAssignable, Category = "Extra Functionality Library|Replay")
+	FOnExtraReplayCatalogRefreshed OnCatalogRefreshed;
+
+	/** Refreshes within this many seconds of the last one reuse the cached list unless forced. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Extra Functionality Library|Replay", meta = (ClampMin = 0.0f))
+	float MinRefreshInterval;
+
+	/** Remembers which replay is currently recording so users added through AddUserToReplay get associated with it. */
+	void NotifyRecordingStarted(const FString& ReplayName);
+	void NotifyRecordingStopped();
+	void NotifyUserAdded(const FString& UserString);
+
+private:
+
+	void OnEnumerateStreamsComplete(const FEnumerateStreamsResult& Result);
+
+	/** Returns the file the catalog is cached in between sessions */
+	FString GetIndexFilePath() const;
+	void LoadIndex();
+	/** Serializes the catalog on the game thread and writes it to disk on a background thread */
+	void SaveIndexAsync() const;
+
+	TSharedPtr<INetworkReplayStreamer> ReplayStreamer;
+
+	TArray<FExtraReplayInfo> Replays;
+
+	/** Users added per replay name, kept separately since the streamer's header doesn't contain them */
+	TMap<FString, TArray<FString>> ReplayUsers;
+
+	FString ActiveRecordingName;
+
+	double LastRefreshTime;
+
+	uint8 bRefreshInProgress : 1;
+
+};
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "ExtraDataTypes.h"
+#include "ExtraScalability.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogExtraScalability, Log, All);
+
+/**
+* Table mapping the startup CPU benchmark to scalability settings and the plugin's own budgets.
+* Found under Project Settings > Plugins > Extra Functionality Scalability.
+*/
+UCLASS(config = Game, defaultconfig, meta = (DisplayName = "Extra Functionality Scalability"))
+class EXTRAFUNCTIONALITY_API UExtraScalabilitySettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+
+	UExtraScalabilitySettings();
+
+	virtual FName GetCategoryName() const override { return TEXT("Plugins"); }
+
+	/** Runs(or loads the cached result of) the CPU benchmark when the module starts up, and picks a tier from it */
+	UPROPERTY(config, EditAnywhere, Category = "Benchmark")
+	bool bAutoConfigureAtStartup;
+
+	/** Applies the picked tier's scalability level when the benchmark is actually measured at startup, so a player's own settings are kept on later launches */
+	UPROPERTY(config, EditAnywhere, Category = "Benchmark", meta = (EditCondition = "bAutoConfigureAtStartup"))
+	bool bApplyScalabilityLevel;
+
+	/** How much the multi thread score counts towards the combined score the tiers are picked by, the rest is the single thread score */
+	UPROPERTY(config, EditAnywhere, Category = "Benchmark", meta = (ClampMin = 0.0f, ClampMax = 1.0f))
+	float MultiThreadWeight;
+
+	/** The highest tier whose MinScore the combined score reaches is picked */
+	UPROPERTY(config, EditAnywhere, Category = "Tiers")
+	TArray<FExtraScalabilityTier> Tiers;
+
+};
+
+/**
+* Runs the CPU benchmark and keeps the tier it picked, the result is cached in the saved folder
+* so later launches on the same hardware skip the benchmark.
+*/
+class EXTRAFUNCTIONALITY_API FExtraScalability
+{
+public:
+
+	/** Loads the cached result or runs the benchmark and picks a tier from it, called when the module starts up. Skipped in the editor, commandlets and dedicated servers. */
+	static void AutoConfigure();
+
+	/** Applies the picked tier's scalability level if the benchmark was measured this launch, called once the engine has started. */
+	static void ApplyStartupScalabilityLevel();
+
+	/**
+	* Measures single and multi thread scores, takes a few milliseconds.
+	* @param bForce Runs the benchmark even if there is a cached result for this hardware.
+	*/
+	static const FExtraCPUBenchmarkResult& RunBenchmark(bool bForce);
+
+	/** Picks the tier for the current result, the budgets of the tier are used from then on. */
+	static void SelectTier();
+
+	/** Applies the picked tier's overall scalability level to the game user settings. */
+	static void ApplyScalabilityLevel();
+
+	static const FExtraCPUBenchmarkResult& GetResult() { return Result; }
+
+	/** Returns the picked tier, null if the benchmark hasn't run or there are no tiers. */
+	static const FExtraScalabilityTier* GetActiveTier();
+
+	/** The active tier's spline build budget, Default if there is no tier */
+	static float GetSplineBuildBudgetMs(float Default);
+
+	/** The active tier's async traces per frame, Default if there is no tier */
+	static int32 GetTracesPerFrame(int32 Default);
+
+	static FString GetCacheFilePath();
+
+private:
+
+	static bool LoadCache(FExtraCPUBenchmarkResult& OutResult);
+	static void SaveCache(const FExtraCPUBenchmarkResult& InResult);
+
+	static FExtraCPUBenchmarkResult Result;
+	static FExtraScalabilityTier ActiveTier;
+	static bool bHasActiveTier;
+
+};
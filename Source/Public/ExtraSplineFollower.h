@@ -0,0 +1,167 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ExtraDataTypes.h"
+#include "ExtraSplineFollower.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogExtraSplineFollower, Log, All);
+
+class USplineComponent;
+class UExtraSplineSampleTable;
+class UExtraSplineFollowerComponent;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FExtraSplineFollowerDelegate, UExtraSplineFollowerComponent*, Follower);
+
+/**
+* Moves the owner of this component along a spline, without ticking the component itself.
+* The distance and speed live in the world's spline follower subsystem which moves every follower at once.
+*/
+UCLASS(ClassGroup = (Utility), meta = (BlueprintSpawnableComponent))
+class EXTRAFUNCTIONALITY_API UExtraSplineFollowerComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+	friend class UExtraSplineFollowerSubsystem;
+
+public:
+
+	UExtraSplineFollowerComponent();
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Switches to following SplineComp from the current distance, null stops following. */
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline|Follower")
+	void SetSpline(USplineComponent* SplineComp);
+
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline|Follower")
+	USplineComponent* GetSpline() const { return Spline; }
+
+	/** Units per second along the spline, negative moves towards the start */
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline|Follower")
+	void SetSpeed(float NewSpeed);
+
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline|Follower")
+	float GetSpeed() const;
+
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline|Follower")
+	void SetDistance(float NewDistance);
+
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline|Follower")
+	float GetDistance() const;
+
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline|Follower")
+	void SetEndBehavior(EExtraSplineFollowEndBehavior NewEndBehavior);
+
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline|Follower")
+	void SetFollowRotation(bool bNewFollowRotation);
+
+	/** Called when the follower reaches either end of the spline */
+	UPROPERTY(BlueprintAssignable)
+	FExtraSplineFollowerDelegate OnReachedEnd;
+
+	/** Actor whose first spline component is followed when play begins, unless SetSpline was already called */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Extra Functionality Library|Spline|Follower")
+	AActor* SplineActor;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Extra Functionality Library|Spline|Follower")
+	float Speed;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Extra Functionality Library|Spline|Follower", meta = (ClampMin = 0.0f))
+	float StartDistance;
+
+	/** Set with SetEndBehavior once play has begun */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Extra Functionality Library|Spline|Follower")
+	EExtraSplineFollowEndBehavior EndBehavior;
+
+	/** When false only the location of the owner follows the spline, set with SetFollowRotation once play has begun */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Extra Functionality Library|Spline|Follower")
+	bool bFollowRotation;
+
+private:
+
+	UPROPERTY()
+	USplineComponent* Spline;
+
+	/** Index into the subsystem's arrays, INDEX_NONE while not registered */
+	int32 FollowerIndex;
+
+};
+
+/**
+* Moves every spline follower in the world in one tick instead of each actor ticking on its own.
+* Follower state is kept in parallel arrays, each frame every follower is advanced and its transform is sampled
+* from a sample table of its spline(shared by all followers of that spline and released with the last of them) in a ParallelFor,
+* then all of the transforms are written back to the actors in a single pass on the game thread.
+*/
+UCLASS()
+class EXTRAFUNCTIONALITY_API UExtraSplineFollowerSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	UExtraSplineFollowerSubsystem();
+
+	virtual void Deinitialize() override;
+
+	/** Helper for getting the subsystem from any world context object, returns null if the world is invalid. */
+	static UExtraSplineFollowerSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Starts moving Follower's owner, uses the component's spline, speed and start distance. */
+	void RegisterFollower(UExtraSplineFollowerComponent* Follower);
+	void UnregisterFollower(UExtraSplineFollowerComponent* Follower);
+
+	void SetFollowerSpline(UExtraSplineFollowerComponent* Follower, USplineComponent* SplineComp);
+	void SetFollowerSpeed(UExtraSplineFollowerComponent* Follower, float Speed);
+	void SetFollowerDistance(UExtraSplineFollowerComponent* Follower, float Distance);
+	void SetFollowerEndBehavior(UExtraSplineFollowerComponent* Follower, EExtraSplineFollowEndBehavior EndBehavior);
+	void SetFollowerRotation(UExtraSplineFollowerComponent* Follower, bool bFollowRotation);
+	float GetFollowerSpeed(const UExtraSplineFollowerComponent* Follower) const;
+	float GetFollowerDistance(const UExtraSplineFollowerComponent* Follower) const;
+
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline|Follower")
+	int32 GetNumFollowers() const { return Followers.Num(); }
+
+	/** Sample table accuracy for splines followed from now on, see UExtraSplineSampleTable */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Extra Functionality Library|Spline|Follower", meta = (ClampMin = 0.01f))
+	float MaxPositionError;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return Followers.Num() > 0; }
+	virtual TStatId GetStatId() const override;
+
+private:
+
+	/** Returns the index of SplineComp's sample table with a reference added for a follower, creating the table if needed */
+	int32 FindOrAddTable(USplineComponent* SplineComp);
+	/** Removes a follower's reference to a table, the table is thrown away once no follower uses it */
+	void ReleaseTable(int32 TableIndex);
+	bool IsRegistered(const UExtraSplineFollowerComponent* Follower) const;
+
+	// One entry per follower in each of these
+	UPROPERTY()
+	TArray<UExtraSplineFollowerComponent*> Followers;
+	TArray<int32> TableIndices;
+	TArray<float> Distances;
+	TArray<float> Speeds;
+	TArray<EExtraSplineFollowEndBehavior> EndBehaviors;
+	TArray<bool> FollowRotations;
+	TArray<FTransform> Transforms;
+	/** Written by the parallel pass, read back on the game thread */
+	TArray<bool> Moved;
+	TArray<bool> ReachedEnd;
+
+	/** Released tables leave a null slot that's reused, since followers refer to tables by index */
+	UPROPERTY()
+	TArray<UExtraSplineSampleTable*> Tables;
+	/** How many followers use each table */
+	TArray<int32> TableRefCounts;
+	TArray<int32> FreeTables;
+	TMap<TWeakObjectPtr<USplineComponent>, int32> TableLookup;
+
+};
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ExtraDataTypes.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "Tickable.h"
+#include "ExtraSplineMeshBuilder.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogExtraSplineMeshBuilder, Log, All);
+
+class USplineComponent;
+class USplineMeshComponent;
+class UMaterialInterface;
+class UBoxComponent;
+
+/** Everything needed to set up a single spline mesh tile, in the spline component's local space */
+struct FExtraSplineMeshTile
+{
+	FVector StartLocation;
+	FVector StartTangent;
+	FVector EndLocation;
+	FVector EndTangent;
+	FVector UpDir;
+	/** In radians */
+	float StartRoll;
+	float EndRoll;
+	/** Distance along the spline of the middle of the tile */
+	float MidPointDistance;
+};
+
+/** Shared by BuildSplineMeshesAlongSpline and the async builder so both make identical tiles */
+struct EXTRAFUNCTIONALITY_API FExtraSplineMeshBuilder
+{
+	/**
+	* Bases the up vector of each spline point on its rotation(same as BuildSplineMeshesAlongSpline always has),
+	* then computes every tile along the spline without creating any components.
+	*/
+	static void ComputeTiles(USplineComponent* SplineComp, const FExtraSplineConstructionInfo& ConstructionInfo, TArray<FExtraSplineMeshTile>& OutTiles);
+
+	/** Returns the materials every tile should use, so they're only looked up once per build */
+	static TArray<UMaterialInterface*> GetTileMaterials(const FExtraSplineConstructionInfo& ConstructionInfo);
+
+	/** Creates, sets up and registers the spline mesh component for Tile. */
+	static USplineMeshComponent* CreateTileComponent(USplineComponent* SplineComp, const FExtraSplineConstructionInfo& ConstructionInfo,
+		const TArray<UMaterialInterface*>& Materials, const FExtraSplineMeshTile& Tile);
+
+	/**
+	* Makes one box collision component for every TilesPerCollisionBody tiles, does nothing if TilesPerCollisionBody is 0 or collision is disabled.
+	* The boxes are attached to the spline and tagged with CollisionBodyTag.
+	*/
+	static TArray<UBoxComponent*> CreateCollisionBodies(USplineComponent* SplineComp, const FExtraSplineConstructionInfo& ConstructionInfo,
+		TArrayView<const FExtraSplineMeshTile> Tiles);
+
+	/** Tag given to the collision boxes made by CreateCollisionBodies */
+	static const FName CollisionBodyTag;
+
+	/**
+	* CPU version of USplineMeshComponent's slice transform, the transform a slice of the mesh at Alpha(0-1 along the mesh's forward axis) is deformed with.
+	* Vertices should have their forward axis component zeroed before being transformed.
+	*/
+	static FTransform CalcSliceTransform(const FExtraSplineMeshTile& Tile, const FExtraSplineConstructionInfo& ConstructionInfo, float Alpha);
+
+	/** Draws the axes of every tile with the debug draw layer in one go if ConstructionInfo is in debug mode. */
+	static void DrawTilesDebug(const USplineComponent* SplineComp, const FExtraSplineConstructionInfo& ConstructionInfo, TArrayView<const FExtraSplineMeshTile> Tiles);
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FExtraSplineMeshBuildDelegate, float, Progress, const TArray<USplineMeshComponent*>&, SplineMeshes);
+
+/**
+* Builds spline meshes along a spline over multiple frames.
+* All of the tiles are computed when the build starts, then components are created and registered
+* a few at a time each frame so that no single frame goes over the millisecond budget.
+*/
+UCLASS()
+class EXTRAFUNCTIONALITY_API UExtraBuildSplineMeshesAction : public UBlueprintAsyncActionBase, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	UExtraBuildSplineMeshesAction();
+
+	/**
+	* Time sliced version of BuildSplineMeshesAlongSpline.
+	* @param MillisecondsPerFrame How long each frame can spend creating components, at least one tile is always created per frame.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline",
+		meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject", MillisecondsPerFrame = "2.0"))
+	static UExtraBuildSplineMeshesAction* BuildSplineMeshesAlongSplineAsync(UObject* WorldContextObject, USplineComponent* SplineComp,
+		FExtraSplineConstructionInfo ConstructionInfo, float MillisecondsPerFrame = 2.0f);
+
+	/** Called after every frame of building with the components that have been made so far */
+	UPROPERTY(BlueprintAssignable)
+	FExtraSplineMeshBuildDelegate OnProgress;
+
+	/** Called once every tile has been made */
+	UPROPERTY(BlueprintAssignable)
+	FExtraSplineMeshBuildDelegate OnCompleted;
+
+	/** Called if the spline was destroyed or the build was cancelled before it finished, with the components that were already made */
+	UPROPERTY(BlueprintAssignable)
+	FExtraSplineMeshBuildDelegate OnFailed;
+
+	/** Stops building, the components that were already made are kept. */
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline")
+	void Cancel();
+
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline")
+	float GetProgress() const { return (Tiles.Num() > 0) ? ((float)NextTile / Tiles.Num()) : 1.0f; }
+
+	// UBlueprintAsyncActionBase interface
+	virtual void Activate() override;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return bIsBuilding; }
+	virtual bool IsTickableInEditor() const override { return true; }
+	virtual TStatId GetStatId() const override;
+
+private:
+
+	void Finish(bool bSuccess);
+
+	UPROPERTY()
+	TWeakObjectPtr<USplineComponent> Spline;
+
+	UPROPERTY()
+	FExtraSplineConstructionInfo ConstructionInfo;
+
+	UPROPERTY()
+	TArray<UMaterialInterface*> Materials;
+
+	UPROPERTY()
+	TArray<USplineMeshComponent*> SplineMeshes;
+
+	TArray<FExtraSplineMeshTile> Tiles;
+	int32 NextTile;
+	float MillisecondsPerFrame;
+	bool bIsBuilding;
+
+};
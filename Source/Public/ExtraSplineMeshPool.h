@@ -0,0 +1,96 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ExtraDataTypes.h"
+#include "ExtraSplineMeshPool.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogExtraSplineMeshPool, Log, All);
+
+class AActor;
+class USplineComponent;
+class USplineMeshComponent;
+
+/**
+* Recycles spline mesh components so rebuilding spline meshes doesn't keep creating new components for the garbage collector.
+* Released components are unregistered, detached and reset, then kept until something acquires one again.
+* With bPerSplinePools the components stay with the spline they came from(no renaming needed to reuse them),
+* otherwise every released component goes into a single pool shared by the whole world.
+*/
+UCLASS()
+class EXTRAFUNCTIONALITY_API UExtraSplineMeshPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UExtraSplineMeshPoolSubsystem();
+
+	virtual void Deinitialize() override;
+
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
+	/** Helper for getting the pool from any world context object, returns null if the world is invalid. */
+	static UExtraSplineMeshPoolSubsystem* Get(const UObject* WorldContextObject);
+
+	/**
+	* Returns an unregistered spline mesh component owned by SplineComp, reused from the pool when possible.
+	* The pool takes the component back when SplineComp's actor is destroyed.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline|Pool")
+	USplineMeshComponent* AcquireSplineMesh(USplineComponent* SplineComp);
+
+	/** Gives a spline mesh component back to the pool, destroys it instead if the pool is full. */
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline|Pool")
+	void ReleaseSplineMesh(USplineMeshComponent* SplineMesh);
+
+	/** Gives spline mesh components back to the pool, for example the ones from a previous BuildSplineMeshesAlongSpline before rebuilding. */
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline|Pool")
+	void ReleaseSplineMeshes(const TArray<USplineMeshComponent*>& SplineMeshes);
+
+	/** Creates components up front so the first build doesn't have to. With a spline they go into its pool, otherwise the world pool. */
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline|Pool")
+	void Prewarm(int32 Count, USplineComponent* SplineComp = nullptr);
+
+	/** Destroys every pooled component. */
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline|Pool")
+	void EmptyPool();
+
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline|Pool")
+	FExtraComponentPoolStats GetStats() const;
+
+	/** Pooled components past this amount are destroyed when released */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Extra Functionality Library|Spline|Pool", meta = (ClampMin = 0))
+	int32 MaxPooledComponents;
+
+	/** When true components are pooled per spline component instead of in one pool for the whole world */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Extra Functionality Library|Spline|Pool")
+	bool bPerSplinePools;
+
+private:
+
+	/** Pops a pooled component, preferring ones that already belong to SplineComp */
+	USplineMeshComponent* TakePooledComponent(USplineComponent* SplineComp);
+	/** Pops the last component of Pool that is still alive, null if there are none */
+	USplineMeshComponent* PopPooledComponent(TArray<USplineMeshComponent*>& Pool);
+	/** Resets and stores SplineMesh, in its spline's pool if bKeepWithSpline or in the world pool otherwise */
+	void PoolComponent(USplineMeshComponent* SplineMesh, bool bKeepWithSpline);
+	void ResetComponent(USplineMeshComponent* SplineMesh) const;
+	void BindToOwnerDestroyed(USplineComponent* SplineComp);
+	/** Moves the pools of splines that are gone into the world pool */
+	void PruneSplinePools();
+
+	UFUNCTION()
+	void OnSplineOwnerDestroyed(AActor* DestroyedActor);
+
+	TArray<USplineMeshComponent*> WorldPool;
+	TMap<TWeakObjectPtr<USplineComponent>, TArray<USplineMeshComponent*>> SplinePools;
+	/** Components made by the pool, so we only take back our own components when an actor is destroyed */
+	TSet<TWeakObjectPtr<USplineMeshComponent>> PoolCreatedComponents;
+	/** Components sitting in any of the pools, so a component released twice is only pooled once */
+	TSet<TWeakObjectPtr<USplineMeshComponent>> PooledComponents;
+
+	int32 NumPooled;
+	FExtraComponentPoolStats Stats;
+
+};
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SplineComponent.h"
+#include "UObject/Object.h"
+#include "ExtraSplineQuery.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogExtraSplineQuery, Log, All);
+
+/**
+* Finds the closest point on a spline component much faster than FindInputKeyClosestToWorldLocation, which tests every segment each call.
+* Each segment is split into pieces whose bezier control points bound them, the pieces go into a bounding volume hierarchy so a query
+* only looks at the pieces that could be closer than the best one found so far, then refines the key on those with Newton iterations.
+* The query checks(at most once a frame) if the spline has been changed and rebuilds itself automatically.
+*/
+UCLASS(BlueprintType)
+class EXTRAFUNCTIONALITY_API UExtraSplineQuery : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	UExtraSplineQuery();
+
+	/**
+	* Creates a closest point query for InSpline.
+	* @param SubdivisionsPerSegment How many pieces each segment is split into, more pieces give tighter bounds and fewer Newton iterations are needed.
+	* @param NewtonIterations How many times the key is refined on each piece that's tested.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline|Query", meta = (SubdivisionsPerSegment = "4", NewtonIterations = "4"))
+	static UExtraSplineQuery* CreateSplineQuery(USplineComponent* InSpline, int32 SubdivisionsPerSegment = 4, int32 NewtonIterations = 4);
+
+	/** Rebuilds the hierarchy from the spline right away, even if the spline hasn't changed. */
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline|Query")
+	void Rebuild();
+
+	/** Rebuilds the hierarchy if the spline changed since it was built. Only checks once per frame unless bForceCheck is true. */
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline|Query")
+	void ConditionalRebuild(bool bForceCheck = false);
+
+	/** Returns true if the query has a valid spline and segments to search. */
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline|Query")
+	bool IsValidQuery() const { return Spline.IsValid() && Nodes.Num() > 0; }
+
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline|Query")
+	USplineComponent* GetSpline() const { return Spline.Get(); }
+
+	/** Given a location in world space, return the input key closest to that location. */
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline|Query")
+	float FindInputKeyClosestToWorldLocation(const FVector& WorldLocation);
+
+	/**
+	* Given a location in world space, finds the closest input key, the distance along the spline of that key and the world transform there.
+	* @return Returns false if the query has no spline to search.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline|Query")
+	bool FindClosestToWorldLocation(const FVector& WorldLocation, float& OutInputKey, float& OutDistance, FTransform& OutTransform, bool bUseScale = false);
+
+	/** FindClosestToWorldLocation for many locations at once, spread across multiple threads when there are enough of them. */
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline|Query")
+	bool FindClosestToWorldLocations(const TArray<FVector>& WorldLocations, TArray<float>& OutInputKeys, TArray<float>& OutDistances,
+		TArray<FTransform>& OutTransforms, bool bUseScale = false);
+
+	/**
+	* Returns the input key closest to a location in the spline's local space without checking if the spline changed.
+	* Safe to call from multiple threads at once as long as nothing rebuilds the query at the same time.
+	*/
+	float FindClosestInputKeyLocal(const FVector& LocalLocation) const;
+
+	/** Converts an input key to a distance along the spline with the spline's reparam table, thread safe like FindClosestInputKeyLocal. */
+	float DistanceAtInputKey(float InKey) const;
+
+private:
+
+	/** A piece of a segment as a cubic in V(0-1), P(V) = ((A * V + B) * V + C) * V + D */
+	struct FPiece
+	{
+		FVector A;
+		FVector B;
+		FVector C;
+		FVector D;
+		float StartKey;
+		float KeyRange;
+
+		FVector Eval(float V) const { return ((A * V + B) * V + C) * V + D; }
+		FVector EvalDerivative(float V) const { return (3.0f * A * V + 2.0f * B) * V + C; }
+		FVector EvalSecondDerivative(float V) const { return 6.0f * A * V + 2.0f * B; }
+	};
+
+	struct FNode
+	{
+		FBox Bounds;
+		int32 Left;
+		int32 Right;
+		/** Index into Pieces for leaf nodes, INDEX_NONE for inner nodes */
+		int32 Piece;
+	};
+
+	/** Builds the nodes for PieceIndices[Begin, End) and returns the index of their root node */
+	int32 BuildNode(TArray<int32>& PieceIndices, const TArray<FBox>& PieceBounds, int32 Begin, int32 End);
+
+	/** Returns V(0-1) on Piece closest to Location and its squared distance */
+	float FindClosestOnPiece(const FPiece& Piece, const FVector& Location, float& OutDistanceSquared) const;
+
+	UPROPERTY()
+	TWeakObjectPtr<USplineComponent> Spline;
+
+	TArray<FPiece> Pieces;
+	TArray<FNode> Nodes;
+	int32 RootNode;
+
+	/** The reparam table split into keys and distances so a key can be binary searched */
+	TArray<float> ReparamKeys;
+	TArray<float> ReparamDistances;
+
+	int32 SubdivisionsPerSegment;
+	int32 NewtonIterations;
+
+	uint32 BuiltSplineHash;
+	uint64 LastCheckedFrame;
+
+};
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SplineComponent.h"
+#include "UObject/Object.h"
+#include "ExtraSplineSampleTable.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogExtraSplineSampleTable, Log, All);
+
+/** A single evaluated point on a spline, in the spline component's local space */
+struct FExtraSplineSample
+{
+	FVector Location;
+	FVector Tangent;
+	FQuat Rotation;
+	FVector Scale;
+	float Roll;
+};
+
+/**
+* A baked lookup table of a spline component, sampled uniformly in input key and uniformly in distance.
+* Queries interpolate between the two nearest samples instead of evaluating the spline curves,
+* the sample spacing is picked when building so the interpolated location stays within MaxPositionError of the real spline.
+* The table checks(at most once a frame) if the spline has been changed and rebuilds itself automatically.
+*/
+UCLASS(BlueprintType)
+class EXTRAFUNCTIONALITY_API UExtraSplineSampleTable : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	UExtraSplineSampleTable();
+
+	/**
+	* Creates a sample table for InSpline.
+	* @param MaxPositionError The furthest an interpolated location is allowed to be from the exact spline location, smaller values use more samples.
+	* @param MaxSamplesPerSegment Caps how many samples a segment can use regardless of MaxPositionError.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline|Sample Table", meta = (MaxPositionError = "1.0", MaxSamplesPerSegment = "256"))
+	static UExtraSplineSampleTable* CreateSplineSampleTable(USplineComponent* InSpline, float MaxPositionError = 1.0f, int32 MaxSamplesPerSegment = 256);
+
+	/** Rebuilds the table from the spline right away, even if the spline hasn't changed. */
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline|Sample Table")
+	void Rebuild();
+
+	/** Rebuilds the table if the spline changed since it was built. Only checks once per frame unless bForceCheck is true. */
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Spline|Sample Table")
+	void ConditionalRebuild(bool bForceCheck = false);
+
+	/** Returns true if the table has a valid spline and samples to query. */
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline|Sample Table")
+	bool IsValidTable() const { return Spline.IsValid() && KeySamples.Locations.Num() > 1; }
+
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline|Sample Table")
+	USplineComponent* GetSpline() const { return Spline.Get(); }
+
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline|Sample Table")
+	float GetSplineLength() const { return SplineLength; }
+
+	/** Returns the highest measured error of the interpolated location against the real spline from the last build. */
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline|Sample Table")
+	float GetMeasuredPositionError() const { return MeasuredPositionError; }
+
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline|Sample Table")
+	int32 GetNumSamples() const { return KeySamples.Locations.Num() + DistanceSamples.Locations.Num(); }
+
+	/** Get location along spline at the provided input key value */
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline|Sample Table")
+	FVector GetLocationAtInputKey(float InKey, ESplineCoordinateSpace::Type CoordinateSpace);
+
+	/** Get tangent along spline at the provided input key value */
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline|Sample Table")
+	FVector GetTangentAtInputKey(float InKey, ESplineCoordinateSpace::Type CoordinateSpace);
+
+	/** Get rotator corresponding to rotation along spline at the provided input key value */
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline|Sample Table")
+	FRotator GetRotationAtInputKey(float InKey, ESplineCoordinateSpace::Type CoordinateSpace);
+
+	/** Get scale at the provided input key value along spline */
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline|Sample Table")
+	FVector GetScaleAtInputKey(float InKey);
+
+	/** Get roll in degrees at the provided input key value along spline */
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline|Sample Table")
+	float GetRollAtInputKey(float InKey, ESplineCoordinateSpace::Type CoordinateSpace);
+
+	/** Get transform at the provided input key value along spline */
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline|Sample Table")
+	FTransform GetTransformAtInputKey(float InKey, ESplineCoordinateSpace::Type CoordinateSpace, bool bUseScale = false);
+
+	/** Get location along spline at the provided distance */
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline|Sample Table")
+	FVector GetLocationAtDistance(float Distance, ESplineCoordinateSpace::Type CoordinateSpace);
+
+	/** Get tangent along spline at the provided distance */
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline|Sample Table")
+	FVector GetTangentAtDistance(float Distance, ESplineCoordinateSpace::Type CoordinateSpace);
+
+	/** Get rotator corresponding to rotation along spline at the provided distance */
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline|Sample Table")
+	FRotator GetRotationAtDistance(float Distance, ESplineCoordinateSpace::Type CoordinateSpace);
+
+	/** Get scale along spline at the provided distance */
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline|Sample Table")
+	FVector GetScaleAtDistance(float Distance);
+
+	/** Get roll in degrees along spline at the provided distance */
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline|Sample Table")
+	float GetRollAtDistance(float Distance, ESplineCoordinateSpace::Type CoordinateSpace);
+
+	/** Get transform along spline at the provided distance */
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline|Sample Table")
+	FTransform GetTransformAtDistance(float Distance, ESplineCoordinateSpace::Type CoordinateSpace, bool bUseScale = false);
+
+	/** Get the input key at the provided distance */
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Spline|Sample Table")
+	float GetInputKeyAtDistance(float Distance);
+
+	/**
+	* Interpolates the local space sample at InKey/Distance without checking if the spline changed.
+	* Safe to call from multiple threads at once as long as nothing rebuilds the table at the same time.
+	*/
+	FExtraSplineSample SampleAtInputKey(float InKey) const;
+	FExtraSplineSample SampleAtDistance(float Distance) const;
+	float InputKeyAtDistance(float Distance) const;
+
+	/** Converts a local space sample into a transform in CoordinateSpace, ComponentTransform is only used for world space. */
+	static FTransform SampleToTransform(const FExtraSplineSample& Sample, ESplineCoordinateSpace::Type CoordinateSpace,
+		const FTransform& ComponentTransform, bool bUseScale);
+
+	/** Returns the spline's component to world transform, or identity if the spline is gone. */
+	FTransform GetComponentTransform() const;
+
+private:
+
+	/** Each sample channel in its own array so queries only touch the channels they need */
+	struct FSampleChannels
+	{
+		TArray<FVector> Locations;
+		TArray<FVector> Tangents;
+		TArray<FQuat> Rotations;
+		TArray<FVector> Scales;
+		TArray<float> Rolls;
+		/** The key each sample was taken at, filled for both tables but only read from the distance table */
+		TArray<float> InputKeys;
+
+		void Reset(int32 NewSize);
+		void AddSample(const USplineComponent* InSpline, float InKey);
+		FExtraSplineSample Interpolate(int32 Index, float Alpha) const;
+	};
+
+	/** Finds the lower sample index and the alpha to the next sample for Value in a table with uniform Spacing */
+	static void FindSampleIndex(float Value, float Spacing, int32 NumSamples, int32& OutIndex, float& OutAlpha);
+
+	/** Returns the highest distance between the interpolated and the exact location at the midpoint of every pair of samples */
+	float MeasureKeyTableError() const;
+	float MeasureDistanceTableError() const;
+
+	UPROPERTY()
+	TWeakObjectPtr<USplineComponent> Spline;
+
+	FSampleChannels KeySamples;
+	FSampleChannels DistanceSamples;
+
+	float KeySpacing;
+	float DistanceSpacing;
+	float MaxInputKey;
+	float SplineLength;
+
+	float MaxPositionError;
+	int32 MaxSamplesPerSegment;
+	float MeasuredPositionError;
+
+	uint32 BuiltSplineHash;
+	uint64 LastCheckedFrame;
+
+};
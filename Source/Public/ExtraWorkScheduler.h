@@ -0,0 +1,133 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Engine/EngineTypes.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Tickable.h"
+#include "ExtraDataTypes.h"
+#include "ExtraWorkScheduler.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogExtraWorkScheduler, Log, All);
+
+DECLARE_DYNAMIC_DELEGATE_OneParam(FExtraWorkCompleteDelegate, bool, bSucceeded);
+DECLARE_DYNAMIC_DELEGATE_OneParam(FExtraSubDirectoriesDelegate, const TArray<FString>&, Directories);
+DECLARE_DYNAMIC_DELEGATE_OneParam(FExtraSplineMeshesDelegate, const TArray<USplineMeshComponent*>&, SplineMeshes);
+
+class USplineComponent;
+class USplineMeshComponent;
+
+/**
+* Runs heavy work spread across frames so it doesn't hitch.
+* Game thread work is split into steps, each frame steps are run(highest priority first) until the frame budget is used up.
+* Work that is safe off the game thread runs on the thread pool instead, with its completion handed back on the game thread.
+*/
+UCLASS()
+class EXTRAFUNCTIONALITY_API UExtraWorkSchedulerSubsystem : public UGameInstanceSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Does a small piece of work, sets OutProgress(0-1) and returns true once all of the work is done. */
+	typedef TFunction<bool(float& OutProgress)> FStepFunction;
+	/** Runs on a worker thread, should check bCancelled every so often and bail out early if it's set. */
+	typedef TFunction<void(const FThreadSafeBool& bCancelled)> FAsyncFunction;
+
+	UExtraWorkSchedulerSubsystem();
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Helper for getting the scheduler from any world context object, returns null if there is no game instance. */
+	static UExtraWorkSchedulerSubsystem* Get(const UObject* WorldContextObject);
+
+	/**
+	* Schedules game thread work that will be stepped every frame within the frame budget until it returns true.
+	* @return Returns a handle to query or cancel the work with, never 0.
+	*/
+	int32 ScheduleSteppedWork(FName DebugName, EExtraWorkPriority Priority, FStepFunction&& Step);
+
+	/**
+	* Schedules work to run on the thread pool, OnGameThreadComplete is called on the game thread once it finishes(unless it was cancelled).
+	* Only MaxConcurrentAsyncWork run at once, the rest wait in priority order.
+	*/
+	int32 ScheduleAsyncWork(FName DebugName, EExtraWorkPriority Priority, FAsyncFunction&& Work, TFunction<void()>&& OnGameThreadComplete);
+
+	/** Cancels scheduled work, work already running on a worker thread is told to stop and its completion is skipped. */
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Work Scheduler")
+	bool CancelWork(int32 WorkHandle);
+
+	/** Returns true if the work hasn't finished and wasn't cancelled. */
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Work Scheduler")
+	bool IsWorkPending(int32 WorkHandle) const;
+
+	/** Returns false if the work is no longer pending, worker thread work only reports 0 or 1. */
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Work Scheduler")
+	bool GetWorkProgress(int32 WorkHandle, float& OutProgress) const;
+
+	UFUNCTION(BlueprintPure, Category = "Extra Functionality Library|Work Scheduler")
+	FExtraWorkSchedulerStats GetStats() const;
+
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Work Scheduler")
+	void ResetStats();
+
+	/** GetSubDirectories on a worker thread. */
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Work Scheduler")
+	int32 ScheduleGetSubDirectories(const FString& InDir, bool bDeepSearch, EExtraWorkPriority Priority, FExtraSubDirectoriesDelegate OnComplete);
+
+	/** SnapAllSplinePointsToGround with a spline point snapped per step. */
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Work Scheduler", meta = (TraceDistance = "1000.0", AutoCreateRefTerm = "ActorsToIgnore"))
+	int32 ScheduleSnapAllSplinePointsToGround(USplineComponent* SplineComp, float TraceDistance, bool bTraceComplex,
+		ETraceTypeQuery TraceChannel, const TArray<AActor*>& ActorsToIgnore, EExtraWorkPriority Priority, FExtraWorkCompleteDelegate OnComplete);
+
+	/** BuildSplineMeshesAlongSpline with a spline mesh tile built per step. */
+	UFUNCTION(BlueprintCallable, Category = "Extra Functionality Library|Work Scheduler")
+	int32 ScheduleBuildSplineMeshesAlongSpline(USplineComponent* SplineComp, FExtraSplineConstructionInfo ConstructionInfo,
+		EExtraWorkPriority Priority, FExtraSplineMeshesDelegate OnComplete);
+
+	/** How long game thread work can run each frame, starts at the scalability tier's spline build budget if one was picked */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Extra Functionality Library|Work Scheduler", meta = (ClampMin = 0.0f))
+	float FrameBudgetMs;
+
+	/** How many pieces of worker thread work can run at once */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Extra Functionality Library|Work Scheduler", meta = (ClampMin = 1))
+	int32 MaxConcurrentAsyncWork;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+private:
+
+	struct FWorkItem
+	{
+		int32 Handle;
+		FName DebugName;
+		EExtraWorkPriority Priority;
+		float Progress;
+
+		FStepFunction Step;
+
+		FAsyncFunction AsyncWork;
+		TFunction<void()> OnGameThreadComplete;
+		TSharedPtr<FThreadSafeBool, ESPMode::ThreadSafe> bCancelled;
+		TFuture<void> Future;
+	};
+
+	/** Inserts after every item with the same or higher priority, so equal priorities run in the order they were scheduled */
+	static void InsertByPriority(TArray<FWorkItem>& Queue, FWorkItem&& Item);
+
+	int32 MakeHandle();
+	void StartQueuedAsyncWork();
+
+	TArray<FWorkItem> GameThreadQueue;
+	TArray<FWorkItem> AsyncQueue;
+	TArray<FWorkItem> RunningAsyncWork;
+
+	FExtraWorkSchedulerStats Stats;
+	int32 LastHandle;
+
+};